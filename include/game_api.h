@@ -33,6 +33,9 @@ typedef struct {
     float horizontal_speed;
     float last_jump_time;
     int consecutive_jumps;
+    
+    // Position at the start of the current simulation tick, for interpolation
+    Vector3 previous_position;
 } PlayerState;
 
 // Enemy types
@@ -56,6 +59,7 @@ struct EnemyAI;
 // Enemy state structure
 typedef struct {
     Vector3 position;
+    Vector3 previous_position; // Position at the start of the current tick
     Vector3 velocity;
     Vector3 target_position;
     float health;
@@ -77,6 +81,7 @@ typedef enum {
 // Projectile state structure
 typedef struct {
     Vector3 position;
+    Vector3 previous_position; // Position at the start of the current tick
     Vector3 velocity;
     float damage;
     float lifetime;
@@ -92,21 +97,46 @@ typedef enum {
     GAME_OVER
 } GamePhase;
 
-// Constants
-#define MAX_ENEMIES 50
-#define MAX_PROJECTILES 100
+// Default entity capacities, overridable at startup
+#define DEFAULT_MAX_ENEMIES 50
+#define DEFAULT_MAX_PROJECTILES 100
+
+// Entity handles pack a slot index (low bits) with the slot's generation
+// (high bits) so references to a freed and reused slot can be detected
+#define ENTITY_HANDLE_SLOT_BITS 16
+#define ENTITY_HANDLE_SLOT_MASK ((1 << ENTITY_HANDLE_SLOT_BITS) - 1)
+#define INVALID_ENTITY_HANDLE -1
+#define MAX_ENTITY_CAPACITY (ENTITY_HANDLE_SLOT_MASK + 1)
+
+// Slot pool with a free list and a dense list of live slots
+typedef struct {
+    int capacity;
+    int count;          // Number of live slots
+    int free_count;
+    int* free_slots;    // Stack of unused slot indices
+    int* alive;         // Dense list of live slot indices, used for iteration
+    int* alive_index;   // Slot -> position in alive, -1 when the slot is free
+    int* generations;   // Per-slot generation, bumped when a slot is released
+} EntityPool;
 
 // Main game state structure
 typedef struct {
     PlayerState player;
-    Enemy enemies[MAX_ENEMIES];
-    Projectile projectiles[MAX_PROJECTILES];
+    Enemy* enemies;             // max_enemies entries, indexed by pool slot
+    Projectile* projectiles;    // max_projectiles entries, indexed by pool slot
+    int max_enemies;
+    int max_projectiles;
     int score;
     int enemy_count;
     int projectile_count;
     float delta_time;
     int game_running;
     GamePhase current_phase;
+    float interpolation_alpha;  // Render blend between previous and current tick, 0..1
+    
+    // Slot bookkeeping for enemies[] and projectiles[]
+    EntityPool enemy_pool;
+    EntityPool projectile_pool;
 } GameState;
 
 // Input state structure
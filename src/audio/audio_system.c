@@ -1,4 +1,6 @@
 #include "audio_system.h"
+#include "../core/log.h"
+#include "../core/rng.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -37,7 +39,7 @@ static int g_current_music_source = -1;
 
 // Internal functions
 static int find_free_source();
-static void cleanup_finished_sources();
+static void cleanup_finished_sources(float delta_time);
 static float apply_volume_settings(float base_volume, AudioType type);
 
 int init_audio_system() {
@@ -198,7 +200,7 @@ int play_sound_2d(SoundType type, float volume, float pitch) {
     
     int source_index = find_free_source();
     if (source_index == -1) {
-        printf("Warning: No free audio sources available\n");
+        LOG_WARN(LOG_CATEGORY_AUDIO, "No free audio sources available");
         return -1;
     }
     
@@ -212,8 +214,8 @@ int play_sound_2d(SoundType type, float volume, float pitch) {
     
     g_audio_settings.current_sources++;
     
-    printf("Playing 2D sound: %s (ID: %d, Volume: %.2f, Pitch: %.2f)\n", 
-           g_sounds[type].filename, source->sound_id, source->volume, source->pitch);
+    LOG_DEBUG(LOG_CATEGORY_AUDIO, "Playing 2D sound: %s (ID: %d, Volume: %.2f, Pitch: %.2f)", 
+              g_sounds[type].filename, source->sound_id, source->volume, source->pitch);
     
     return source->sound_id;
 }
@@ -231,7 +233,7 @@ int play_sound_3d(SoundType type, Vector3 position, float volume, float pitch) {
     
     int source_index = find_free_source();
     if (source_index == -1) {
-        printf("Warning: No free audio sources available\n");
+        LOG_WARN(LOG_CATEGORY_AUDIO, "No free audio sources available");
         return -1;
     }
     
@@ -249,9 +251,9 @@ int play_sound_3d(SoundType type, Vector3 position, float volume, float pitch) {
     
     g_audio_settings.current_sources++;
     
-    printf("Playing 3D sound: %s at (%.1f, %.1f, %.1f) (ID: %d, Volume: %.2f)\n", 
-           g_sounds[type].filename, position.x, position.y, position.z, 
-           source->sound_id, source->volume);
+    LOG_DEBUG(LOG_CATEGORY_AUDIO, "Playing 3D sound: %s at (%.1f, %.1f, %.1f) (ID: %d, Volume: %.2f)", 
+              g_sounds[type].filename, position.x, position.y, position.z, 
+              source->sound_id, source->volume);
     
     return source->sound_id;
 }
@@ -267,7 +269,7 @@ void stop_sound_2d(int source_id) {
         if (g_audio_sources[i].sound_id == source_id) {
             memset(&g_audio_sources[i], 0, sizeof(AudioSource));
             g_audio_settings.current_sources--;
-            printf("Stopped sound ID: %d\n", source_id);
+            LOG_DEBUG(LOG_CATEGORY_AUDIO, "Stopped sound ID: %d", source_id);
             return;
         }
     }
@@ -371,7 +373,7 @@ void set_listener_velocity(Vector3 velocity) {
 }
 
 void update_audio_sources(float delta_time) {
-    cleanup_finished_sources();
+    cleanup_finished_sources(delta_time);
     
     // Update 3D audio sources based on listener position
     for (int i = 0; i < g_audio_settings.max_sources; i++) {
@@ -464,18 +466,18 @@ static int find_free_source() {
     return -1;
 }
 
-static void cleanup_finished_sources() {
+static void cleanup_finished_sources(float delta_time) {
     // In a real implementation, this would check if sounds have finished playing
     // For now, we'll simulate some sounds finishing after a short time
     static float cleanup_timer = 0.0f;
-    cleanup_timer += 0.016f; // Assume 60 FPS
+    cleanup_timer += delta_time;
     
     if (cleanup_timer > 2.0f) { // Clean up every 2 seconds
         int cleaned = 0;
         for (int i = 0; i < g_audio_settings.max_sources; i++) {
             if (g_audio_sources[i].sound_id > 0 && !g_audio_sources[i].looping) {
                 // Randomly clean up some non-looping sounds to simulate finishing
-                if ((rand() % 10) < 3) { // 30% chance
+                if (random_int(RNG_STREAM_AUDIO, 10) < 3) { // 30% chance
                     memset(&g_audio_sources[i], 0, sizeof(AudioSource));
                     g_audio_settings.current_sources--;
                     cleaned++;
@@ -483,7 +485,7 @@ static void cleanup_finished_sources() {
             }
         }
         if (cleaned > 0) {
-            printf("Cleaned up %d finished audio sources\n", cleaned);
+            LOG_DEBUG(LOG_CATEGORY_AUDIO, "Cleaned up %d finished audio sources", cleaned);
         }
         cleanup_timer = 0.0f;
     }
@@ -1,7 +1,7 @@
 #ifndef AUDIO_SYSTEM_H
 #define AUDIO_SYSTEM_H
 
-#include "../game_api.h"
+#include "game_api.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -1,4 +1,5 @@
 #include "sound_generator.h"
+#include "../core/rng.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
@@ -222,7 +223,7 @@ void generate_noise(FILE* file, int duration_ms, int sample_rate, float amplitud
     
     for (int i = 0; i < samples; i++) {
         float decay = 1.0f - (float)i / samples; // Linear decay
-        float sample = amplitude * decay * ((float)rand() / RAND_MAX * 2.0f - 1.0f);
+        float sample = amplitude * decay * random_range(RNG_STREAM_AUDIO, -1.0f, 1.0f);
         short sample_16 = (short)(sample * 32767);
         fwrite(&sample_16, 2, 1, file);
     }
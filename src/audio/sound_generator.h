@@ -1,6 +1,8 @@
 #ifndef SOUND_GENERATOR_H
 #define SOUND_GENERATOR_H
 
+#include <stdio.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -1,5 +1,6 @@
 #include "audio_bridge.h"
 #include "audio/sound_generator.h"
+#include "core/rng.h"
 #include <stdio.h>
 #include <math.h>
 
@@ -57,14 +58,14 @@ void play_player_shoot_sound() {
     if (!g_audio_bridge_initialized) return;
     
     // Add slight pitch variation for variety
-    float pitch = 0.9f + ((float)rand() / RAND_MAX) * 0.2f; // 0.9 to 1.1
+    float pitch = random_range(RNG_STREAM_AUDIO, 0.9f, 1.1f);
     play_sound_2d(SOUND_PLAYER_SHOOT, 0.8f, pitch);
 }
 
 void play_enemy_shoot_sound(Vector3 position) {
     if (!g_audio_bridge_initialized) return;
     
-    float pitch = 0.8f + ((float)rand() / RAND_MAX) * 0.3f; // 0.8 to 1.1
+    float pitch = random_range(RNG_STREAM_AUDIO, 0.8f, 1.1f);
     play_sound_3d(SOUND_ENEMY_SHOOT, position, 0.7f, pitch);
 }
 
@@ -77,7 +78,7 @@ void play_explosion_sound(Vector3 position) {
 void play_enemy_hit_sound(Vector3 position) {
     if (!g_audio_bridge_initialized) return;
     
-    float pitch = 0.9f + ((float)rand() / RAND_MAX) * 0.2f;
+    float pitch = random_range(RNG_STREAM_AUDIO, 0.9f, 1.1f);
     play_sound_3d(SOUND_ENEMY_HIT, position, 0.6f, pitch);
 }
 
@@ -98,8 +99,8 @@ void play_footstep_sound() {
     if (!g_audio_bridge_initialized) return;
     
     // Add variation to footsteps
-    float pitch = 0.8f + ((float)rand() / RAND_MAX) * 0.4f; // 0.8 to 1.2
-    float volume = 0.3f + ((float)rand() / RAND_MAX) * 0.2f; // 0.3 to 0.5
+    float pitch = random_range(RNG_STREAM_AUDIO, 0.8f, 1.2f);
+    float volume = random_range(RNG_STREAM_AUDIO, 0.3f, 0.5f);
     play_sound_2d(SOUND_FOOTSTEP, volume, pitch);
 }
 
@@ -113,7 +114,7 @@ void play_land_sound() {
     if (!g_audio_bridge_initialized) return;
     
     // Landing volume based on fall impact (simplified)
-    float volume = 0.4f + ((float)rand() / RAND_MAX) * 0.3f; // 0.4 to 0.7
+    float volume = random_range(RNG_STREAM_AUDIO, 0.4f, 0.7f);
     play_sound_2d(SOUND_LAND, volume, 1.0f);
 }
 
@@ -121,7 +122,7 @@ void play_bunny_hop_sound() {
     if (!g_audio_bridge_initialized) return;
     
     // Higher pitch for bunny hop excitement
-    float pitch = 1.1f + ((float)rand() / RAND_MAX) * 0.3f; // 1.1 to 1.4
+    float pitch = random_range(RNG_STREAM_AUDIO, 1.1f, 1.4f);
     play_sound_2d(SOUND_BUNNY_HOP, 0.6f, pitch);
 }
 
@@ -0,0 +1,66 @@
+#include "alloc_counter.h"
+#include "atomics.h"
+#include <stddef.h>
+#include <errno.h>
+
+#if defined(SIMPLE_SHOOTER_COUNT_ALLOCS) && defined(__GLIBC__)
+
+// glibc exports its allocator under these names, defining malloc here
+// interposes every caller in the process
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t count, size_t size);
+extern void* __libc_realloc(void* memory, size_t size);
+extern void* __libc_memalign(size_t alignment, size_t size);
+extern void __libc_free(void* memory);
+
+static volatile int64_t g_alloc_count = 0;
+
+void* malloc(size_t size) {
+    atomic_add_i64(&g_alloc_count, 1);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    atomic_add_i64(&g_alloc_count, 1);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* memory, size_t size) {
+    atomic_add_i64(&g_alloc_count, 1);
+    return __libc_realloc(memory, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    atomic_add_i64(&g_alloc_count, 1);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** memory, size_t alignment, size_t size) {
+    atomic_add_i64(&g_alloc_count, 1);
+    *memory = __libc_memalign(alignment, size);
+    return *memory ? 0 : ENOMEM;
+}
+
+void free(void* memory) {
+    __libc_free(memory);
+}
+
+int alloc_counter_available() {
+    return 1;
+}
+
+long long alloc_counter_get() {
+    return (long long)atomic_load_i64(&g_alloc_count);
+}
+
+#else
+
+int alloc_counter_available() {
+    return 0;
+}
+
+long long alloc_counter_get() {
+    return 0;
+}
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Heap allocation counting for zero-allocation checks. Builds with
+// SIMPLE_SHOOTER_COUNT_ALLOCS on glibc replace malloc, calloc, realloc and
+// friends with counting wrappers, which also covers operator new. Elsewhere
+// the counter is unavailable and always reads 0.
+int alloc_counter_available();
+
+// Allocation calls made by any thread since startup
+long long alloc_counter_get();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ALLOC_COUNTER_H
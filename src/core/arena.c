@@ -0,0 +1,150 @@
+#include "arena.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+static Arena g_frame_arena;
+static Arena g_tick_arena;
+
+static ArenaBlock* arena_new_block(size_t capacity) {
+    ArenaBlock* block = (ArenaBlock*)malloc(sizeof(ArenaBlock) + capacity);
+    if (!block) {
+        printf("Arena: failed to allocate block of %zu bytes\n", capacity);
+        return NULL;
+    }
+    
+    block->next = NULL;
+    block->capacity = capacity;
+    block->offset = 0;
+    return block;
+}
+
+static unsigned char* arena_block_data(ArenaBlock* block) {
+    return (unsigned char*)(block + 1);
+}
+
+static void arena_free_blocks(ArenaBlock* block) {
+    while (block) {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+}
+
+int arena_init(Arena* arena, size_t block_size) {
+    memset(arena, 0, sizeof(Arena));
+    arena->block_size = block_size > 0 ? block_size : 4096;
+    
+    arena->head = arena_new_block(arena->block_size);
+    if (!arena->head) {
+        return 0;
+    }
+    
+    arena->reserved = arena->block_size;
+    return 1;
+}
+
+void arena_destroy(Arena* arena) {
+    arena_free_blocks(arena->head);
+    memset(arena, 0, sizeof(Arena));
+}
+
+void* arena_alloc(Arena* arena, size_t size, size_t alignment) {
+    if (!arena->head) {
+        return NULL;
+    }
+    if (alignment == 0) {
+        alignment = ARENA_DEFAULT_ALIGNMENT;
+    }
+    
+    ArenaBlock* block = arena->head;
+    uintptr_t base = (uintptr_t)arena_block_data(block);
+    uintptr_t aligned = (base + block->offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    size_t end = (size_t)(aligned - base) + size;
+    
+    if (end > block->capacity) {
+        // Chain a new block big enough for this request and its alignment
+        size_t capacity = arena->block_size;
+        if (size + alignment > capacity) {
+            capacity = size + alignment;
+        }
+        
+        ArenaBlock* grown = arena_new_block(capacity);
+        if (!grown) {
+            return NULL;
+        }
+        grown->next = block;
+        arena->head = grown;
+        arena->reserved += capacity;
+        
+        block = grown;
+        base = (uintptr_t)arena_block_data(block);
+        aligned = (base + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        end = (size_t)(aligned - base) + size;
+    }
+    
+    arena->used += end - block->offset;
+    block->offset = end;
+    return (void*)aligned;
+}
+
+void* arena_alloc_zeroed(Arena* arena, size_t size, size_t alignment) {
+    void* memory = arena_alloc(arena, size, alignment);
+    if (memory) {
+        memset(memory, 0, size);
+    }
+    return memory;
+}
+
+void arena_reset(Arena* arena) {
+    if (!arena->head) {
+        return;
+    }
+    
+    if (arena->head->next) {
+        // Replace the chain with a single block that holds everything
+        size_t capacity = arena->reserved;
+        ArenaBlock* merged = arena_new_block(capacity);
+        if (merged) {
+            arena_free_blocks(arena->head);
+            arena->head = merged;
+            arena->reserved = capacity;
+            if (capacity > arena->block_size) {
+                arena->block_size = capacity;
+            }
+        } else {
+            // Keep the newest block and drop the rest
+            arena_free_blocks(arena->head->next);
+            arena->head->next = NULL;
+            arena->reserved = arena->head->capacity;
+        }
+    }
+    
+    arena->head->offset = 0;
+    arena->used = 0;
+}
+
+int init_transient_arenas() {
+    if (!arena_init(&g_frame_arena, FRAME_ARENA_BLOCK_SIZE) || !arena_init(&g_tick_arena, TICK_ARENA_BLOCK_SIZE)) {
+        cleanup_transient_arenas();
+        return 0;
+    }
+    
+    printf("Transient arenas initialized - frame %zu KB, tick %zu KB\n",
+           g_frame_arena.reserved / 1024, g_tick_arena.reserved / 1024);
+    return 1;
+}
+
+void cleanup_transient_arenas() {
+    arena_destroy(&g_frame_arena);
+    arena_destroy(&g_tick_arena);
+}
+
+Arena* get_frame_arena() {
+    return &g_frame_arena;
+}
+
+Arena* get_tick_arena() {
+    return &g_tick_arena;
+}
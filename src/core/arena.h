@@ -0,0 +1,56 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bump allocator made of one or more blocks. Allocations are never freed
+// individually; the whole arena is released at once with arena_reset()
+typedef struct ArenaBlock {
+    struct ArenaBlock* next;
+    size_t capacity;
+    size_t offset;
+} ArenaBlock;
+
+typedef struct {
+    ArenaBlock* head;       // Block currently being filled
+    size_t block_size;      // Minimum size of a new block
+    size_t used;            // Bytes handed out since the last reset
+    size_t reserved;        // Bytes owned across all blocks
+} Arena;
+
+#define ARENA_DEFAULT_ALIGNMENT 16
+
+// Arena lifetime
+int arena_init(Arena* arena, size_t block_size);
+void arena_destroy(Arena* arena);
+
+// Allocation - memory is not cleared, use arena_alloc_zeroed for that
+void* arena_alloc(Arena* arena, size_t size, size_t alignment);
+void* arena_alloc_zeroed(Arena* arena, size_t size, size_t alignment);
+
+// Release every allocation. If the arena had to grow, its blocks are merged
+// into one so the next cycle fits without further system allocations
+void arena_reset(Arena* arena);
+
+// Transient arenas for data that lives no longer than one frame or tick.
+// The frame arena belongs to the thread that renders and is reset at the
+// start of every frame; the tick arena belongs to the thread that simulates
+// and is reset at the start of every simulation tick. Never keep pointers
+// into either past the next reset. Per-level storage uses get_level_arena().
+#define FRAME_ARENA_BLOCK_SIZE (256 * 1024)
+#define TICK_ARENA_BLOCK_SIZE (64 * 1024)
+
+int init_transient_arenas();
+void cleanup_transient_arenas();
+Arena* get_frame_arena();
+Arena* get_tick_arena();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ARENA_H
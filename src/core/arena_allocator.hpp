@@ -0,0 +1,57 @@
+#ifndef ARENA_ALLOCATOR_HPP
+#define ARENA_ALLOCATOR_HPP
+
+#include "arena.h"
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// STL allocator drawing from an Arena. deallocate() is a no-op, memory comes
+// back when the arena is reset, so a container must not be touched after
+// that: rebuild it (container = ArenaVector<T>(container.get_allocator()))
+// before using it again. Elements must not need their destructor to run.
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    
+    explicit ArenaAllocator(Arena* arena) noexcept : arena(arena) {}
+    
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.get_arena()) {}
+    
+    T* allocate(std::size_t count) {
+        void* memory = arena_alloc(arena, count * sizeof(T), alignof(T));
+        if (!memory) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(memory);
+    }
+    
+    void deallocate(T*, std::size_t) noexcept {
+    }
+    
+    Arena* get_arena() const noexcept { return arena; }
+
+private:
+    Arena* arena;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept {
+    return a.get_arena() == b.get_arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept {
+    return a.get_arena() != b.get_arena();
+}
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif // ARENA_ALLOCATOR_HPP
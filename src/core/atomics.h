@@ -0,0 +1,95 @@
+#ifndef ATOMICS_H
+#define ATOMICS_H
+
+// Minimal atomic operations on plain integers. MSVC's C compiler has no
+// <stdatomic.h>, so these map to compiler intrinsics on every platform.
+// Loads acquire, stores release and read-modify-write ops are full barriers.
+
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+
+static __inline int32_t atomic_load_i32(volatile int32_t* target) {
+    return _InterlockedOr((volatile long*)target, 0);
+}
+
+static __inline void atomic_store_i32(volatile int32_t* target, int32_t value) {
+    _InterlockedExchange((volatile long*)target, value);
+}
+
+// Returns the previous value
+static __inline int32_t atomic_add_i32(volatile int32_t* target, int32_t value) {
+    return _InterlockedExchangeAdd((volatile long*)target, value);
+}
+
+// Returns the previous value
+static __inline int32_t atomic_exchange_i32(volatile int32_t* target, int32_t value) {
+    return _InterlockedExchange((volatile long*)target, value);
+}
+
+// Returns non-zero when *target held expected and now holds desired
+static __inline int atomic_cas_i32(volatile int32_t* target, int32_t expected, int32_t desired) {
+    return _InterlockedCompareExchange((volatile long*)target, desired, expected) == expected;
+}
+
+static __inline int64_t atomic_load_i64(volatile int64_t* target) {
+    return _InterlockedOr64((volatile __int64*)target, 0);
+}
+
+static __inline void atomic_store_i64(volatile int64_t* target, int64_t value) {
+    _InterlockedExchange64((volatile __int64*)target, value);
+}
+
+static __inline int64_t atomic_add_i64(volatile int64_t* target, int64_t value) {
+    return _InterlockedExchangeAdd64((volatile __int64*)target, value);
+}
+
+static __inline int atomic_cas_i64(volatile int64_t* target, int64_t expected, int64_t desired) {
+    return _InterlockedCompareExchange64((volatile __int64*)target, desired, expected) == expected;
+}
+
+#else
+
+static inline int32_t atomic_load_i32(volatile int32_t* target) {
+    return __atomic_load_n(target, __ATOMIC_ACQUIRE);
+}
+
+static inline void atomic_store_i32(volatile int32_t* target, int32_t value) {
+    __atomic_store_n(target, value, __ATOMIC_RELEASE);
+}
+
+// Returns the previous value
+static inline int32_t atomic_add_i32(volatile int32_t* target, int32_t value) {
+    return __atomic_fetch_add(target, value, __ATOMIC_SEQ_CST);
+}
+
+// Returns the previous value
+static inline int32_t atomic_exchange_i32(volatile int32_t* target, int32_t value) {
+    return __atomic_exchange_n(target, value, __ATOMIC_SEQ_CST);
+}
+
+// Returns non-zero when *target held expected and now holds desired
+static inline int atomic_cas_i32(volatile int32_t* target, int32_t expected, int32_t desired) {
+    return __atomic_compare_exchange_n(target, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+}
+
+static inline int64_t atomic_load_i64(volatile int64_t* target) {
+    return __atomic_load_n(target, __ATOMIC_ACQUIRE);
+}
+
+static inline void atomic_store_i64(volatile int64_t* target, int64_t value) {
+    __atomic_store_n(target, value, __ATOMIC_RELEASE);
+}
+
+static inline int64_t atomic_add_i64(volatile int64_t* target, int64_t value) {
+    return __atomic_fetch_add(target, value, __ATOMIC_SEQ_CST);
+}
+
+static inline int atomic_cas_i64(volatile int64_t* target, int64_t expected, int64_t desired) {
+    return __atomic_compare_exchange_n(target, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+}
+
+#endif
+
+#endif // ATOMICS_H
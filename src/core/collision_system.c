@@ -1,7 +1,11 @@
 #include "collision_system.h"
+#include "log.h"
+#include "rollback.h"
+#include "../audio_bridge.h"
 #include <math.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdlib.h>
 
 void init_collision_system() {
     printf("Collision system initialized\n");
@@ -54,19 +58,26 @@ float vector3_length(Vector3 v) {
 CollisionResult check_sphere_sphere_collision(Vector3 pos1, float radius1, Vector3 pos2, float radius2) {
     CollisionResult result = {0};
     
-    float distance = vector3_distance(pos1, pos2);
     float combined_radius = radius1 + radius2;
     
-    if (distance <= combined_radius) {
-        result.hit = 1;
-        result.distance = distance;
-        result.penetration_depth = combined_radius - distance;
-        
-        // Calculate hit point (on the surface of first sphere)
-        Vector3 direction = vector3_normalize(vector3_subtract(pos2, pos1));
-        result.hit_point = vector3_add(pos1, (Vector3){direction.x * radius1, direction.y * radius1, direction.z * radius1});
-        result.hit_normal = direction;
+    // Reject on squared distance so misses never pay for the sqrtf
+    if (vector3_distance_squared(pos1, pos2) > combined_radius * combined_radius) {
+        return result;
+    }
+    
+    float distance = vector3_distance(pos1, pos2);
+    result.hit = 1;
+    result.distance = distance;
+    result.penetration_depth = combined_radius - distance;
+    
+    // Calculate hit point (on the surface of first sphere), reusing the distance for the normal
+    Vector3 direction = {0.0f, 0.0f, 0.0f};
+    if (distance > 0.0f) {
+        Vector3 offset = vector3_subtract(pos2, pos1);
+        direction = (Vector3){offset.x / distance, offset.y / distance, offset.z / distance};
     }
+    result.hit_point = vector3_add(pos1, (Vector3){direction.x * radius1, direction.y * radius1, direction.z * radius1});
+    result.hit_normal = direction;
     
     return result;
 }
@@ -194,6 +205,182 @@ CollisionResult check_ray_box_collision(Vector3 ray_origin, Vector3 ray_directio
     return result;
 }
 
+CollisionResult check_swept_sphere_collision(Vector3 start, Vector3 end, float radius1, Vector3 pos2, float radius2) {
+    CollisionResult result = {0};
+    
+    // Solve |start + d*t - pos2| = radius1 + radius2 for the smallest t in [0, 1]
+    Vector3 d = vector3_subtract(end, start);
+    Vector3 m = vector3_subtract(start, pos2);
+    float combined_radius = radius1 + radius2;
+    float a = vector3_dot(d, d);
+    float b = vector3_dot(m, d);
+    float c = vector3_dot(m, m) - combined_radius * combined_radius;
+    float t = 0.0f;
+    
+    if (c > 0.0f) {
+        // Not touching at the start, so the sphere must be moving towards pos2
+        if (a <= 1e-12f || b >= 0.0f) {
+            return result;
+        }
+        
+        float discriminant = b * b - a * c;
+        if (discriminant < 0.0f) {
+            return result;
+        }
+        
+        t = (-b - sqrtf(discriminant)) / a;
+        if (t > 1.0f) {
+            return result;
+        }
+    }
+    
+    Vector3 contact_center = vector3_add(start, (Vector3){d.x * t, d.y * t, d.z * t});
+    float distance = vector3_distance(contact_center, pos2);
+    
+    result.hit = 1;
+    result.time_of_impact = t;
+    result.distance = distance;
+    result.penetration_depth = combined_radius - distance;
+    
+    // Hit point on the surface of the moving sphere at the time of impact
+    Vector3 direction = {0.0f, 0.0f, 0.0f};
+    if (distance > 0.0f) {
+        Vector3 offset = vector3_subtract(pos2, contact_center);
+        direction = (Vector3){offset.x / distance, offset.y / distance, offset.z / distance};
+    }
+    result.hit_point = vector3_add(contact_center, (Vector3){direction.x * radius1, direction.y * radius1, direction.z * radius1});
+    result.hit_normal = direction;
+    
+    return result;
+}
+
+// Spatial hash broadphase
+static int spatial_hash_cell(const SpatialHash* hash, float coordinate) {
+    return (int)floorf(coordinate * hash->inv_cell_size);
+}
+
+static int spatial_hash_bucket(const SpatialHash* hash, int x, int y, int z) {
+    unsigned int h = (unsigned int)x * 73856093u ^ (unsigned int)y * 19349663u ^ (unsigned int)z * 83492791u;
+    return (int)(h & (unsigned int)hash->bucket_mask);
+}
+
+// Roughly two buckets per object keeps chains short
+static int spatial_hash_bucket_count(int capacity) {
+    int bucket_count = 16;
+    while (bucket_count < capacity * 2) {
+        bucket_count <<= 1;
+    }
+    return bucket_count;
+}
+
+// Six arrays, each padded up to the default alignment
+size_t spatial_hash_storage_size(int capacity) {
+    return (size_t)spatial_hash_bucket_count(capacity) * sizeof(int) +
+           (size_t)capacity * (5 * sizeof(int) + sizeof(Vector3) + sizeof(float)) +
+           6 * ARENA_DEFAULT_ALIGNMENT;
+}
+
+int spatial_hash_init(SpatialHash* hash, float cell_size, int capacity, Arena* arena) {
+    memset(hash, 0, sizeof(SpatialHash));
+    if (cell_size <= 0.0f || capacity <= 0) {
+        return 0;
+    }
+    
+    int bucket_count = spatial_hash_bucket_count(capacity);
+    hash->bucket_heads = (int*)arena_alloc(arena, sizeof(int) * bucket_count, 0);
+    hash->next = (int*)arena_alloc(arena, sizeof(int) * capacity, 0);
+    hash->ids = (int*)arena_alloc(arena, sizeof(int) * capacity, 0);
+    hash->cells = (int*)arena_alloc(arena, sizeof(int) * 3 * capacity, 0);
+    hash->centers = (Vector3*)arena_alloc(arena, sizeof(Vector3) * capacity, 0);
+    hash->radii = (float*)arena_alloc(arena, sizeof(float) * capacity, 0);
+    
+    if (!hash->bucket_heads || !hash->next || !hash->ids || !hash->cells || !hash->centers || !hash->radii) {
+        printf("Failed to allocate spatial hash for %d objects\n", capacity);
+        memset(hash, 0, sizeof(SpatialHash));
+        return 0;
+    }
+    
+    hash->cell_size = cell_size;
+    hash->inv_cell_size = 1.0f / cell_size;
+    hash->bucket_mask = bucket_count - 1;
+    hash->capacity = capacity;
+    spatial_hash_clear(hash);
+    return 1;
+}
+
+void spatial_hash_clear(SpatialHash* hash) {
+    if (!hash->bucket_heads) return;
+    
+    memset(hash->bucket_heads, 0xff, sizeof(int) * (hash->bucket_mask + 1));
+    hash->count = 0;
+    hash->max_radius = 0.0f;
+}
+
+int spatial_hash_insert(SpatialHash* hash, int id, Vector3 center, float radius) {
+    if (hash->count >= hash->capacity) {
+        return 0;
+    }
+    
+    int entry = hash->count++;
+    int x = spatial_hash_cell(hash, center.x);
+    int y = spatial_hash_cell(hash, center.y);
+    int z = spatial_hash_cell(hash, center.z);
+    int bucket = spatial_hash_bucket(hash, x, y, z);
+    
+    hash->ids[entry] = id;
+    hash->centers[entry] = center;
+    hash->radii[entry] = radius;
+    hash->cells[entry * 3] = x;
+    hash->cells[entry * 3 + 1] = y;
+    hash->cells[entry * 3 + 2] = z;
+    hash->next[entry] = hash->bucket_heads[bucket];
+    hash->bucket_heads[bucket] = entry;
+    
+    if (radius > hash->max_radius) {
+        hash->max_radius = radius;
+    }
+    return 1;
+}
+
+int spatial_hash_query_sphere(const SpatialHash* hash, Vector3 center, float radius, int* out_ids, int max_out) {
+    if (hash->count == 0 || max_out <= 0) {
+        return 0;
+    }
+    
+    float reach = radius + hash->max_radius;
+    int min_x = spatial_hash_cell(hash, center.x - reach);
+    int max_x = spatial_hash_cell(hash, center.x + reach);
+    int min_y = spatial_hash_cell(hash, center.y - reach);
+    int max_y = spatial_hash_cell(hash, center.y + reach);
+    int min_z = spatial_hash_cell(hash, center.z - reach);
+    int max_z = spatial_hash_cell(hash, center.z + reach);
+    
+    int found = 0;
+    for (int x = min_x; x <= max_x; x++) {
+        for (int y = min_y; y <= max_y; y++) {
+            for (int z = min_z; z <= max_z; z++) {
+                int bucket = spatial_hash_bucket(hash, x, y, z);
+                
+                for (int entry = hash->bucket_heads[bucket]; entry >= 0; entry = hash->next[entry]) {
+                    // Buckets are shared by colliding cells, so only accept this cell's entries
+                    const int* cell = &hash->cells[entry * 3];
+                    if (cell[0] != x || cell[1] != y || cell[2] != z) continue;
+                    
+                    float combined = radius + hash->radii[entry];
+                    if (vector3_distance_squared(center, hash->centers[entry]) > combined * combined) continue;
+                    
+                    out_ids[found++] = hash->ids[entry];
+                    if (found >= max_out) {
+                        return found;
+                    }
+                }
+            }
+        }
+    }
+    
+    return found;
+}
+
 // Game-specific collision checks
 int check_projectile_enemy_collision(const Projectile* projectile, const Enemy* enemy, CollisionResult* result) {
     if (!projectile || !enemy || !result) return 0;
@@ -219,6 +406,30 @@ int check_projectile_player_collision(const Projectile* projectile, const Player
     return result->hit;
 }
 
+int check_projectile_enemy_swept(const Projectile* projectile, Vector3 previous_position, const Enemy* enemy, CollisionResult* result) {
+    if (!projectile || !enemy || !result) return 0;
+    
+    CollisionVolume proj_vol = get_projectile_collision_volume(projectile);
+    CollisionVolume enemy_vol = get_enemy_collision_volume(enemy);
+    
+    *result = check_swept_sphere_collision(previous_position, proj_vol.center, proj_vol.radius,
+                                           enemy_vol.center, enemy_vol.radius);
+    
+    return result->hit;
+}
+
+int check_projectile_player_swept(const Projectile* projectile, Vector3 previous_position, const PlayerState* player, CollisionResult* result) {
+    if (!projectile || !player || !result) return 0;
+    
+    CollisionVolume proj_vol = get_projectile_collision_volume(projectile);
+    CollisionVolume player_vol = get_player_collision_volume(player);
+    
+    *result = check_swept_sphere_collision(previous_position, proj_vol.center, proj_vol.radius,
+                                           player_vol.center, player_vol.radius);
+    
+    return result->hit;
+}
+
 int check_enemy_player_collision(const Enemy* enemy, const PlayerState* player, CollisionResult* result) {
     if (!enemy || !player || !result) return 0;
     
@@ -237,10 +448,15 @@ void apply_damage_to_enemy(Enemy* enemy, const DamageInfo* damage) {
     
     enemy->health -= damage->amount;
     
-    printf("Enemy took %.1f damage! Health: %.1f\n", damage->amount, enemy->health);
+    LOG_DEBUG(LOG_CATEGORY_GAMEPLAY, "Enemy took %.1f damage! Health: %.1f", damage->amount, enemy->health);
+    
+    // A re-simulated hit already played its sounds and effects
+    int presented = !rollback_is_resimulating();
     
     // Play hit sound
-    play_enemy_hit_sound(damage->hit_point);
+    if (presented) {
+        play_enemy_hit_sound(damage->hit_point);
+    }
     
     if (enemy->health <= 0.0f) {
         enemy->health = 0.0f;
@@ -248,11 +464,15 @@ void apply_damage_to_enemy(Enemy* enemy, const DamageInfo* damage) {
         enemy->is_active = 0;
         
         // Play death sound
-        play_enemy_death_sound(enemy->position);
-        printf("Enemy killed!\n");
+        if (presented) {
+            play_enemy_death_sound(enemy->position);
+        }
+        LOG_DEBUG(LOG_CATEGORY_GAMEPLAY, "Enemy killed!");
     }
     
-    create_damage_effects(damage);
+    if (presented) {
+        create_damage_effects(damage);
+    }
 }
 
 void apply_damage_to_player(PlayerState* player, const DamageInfo* damage) {
@@ -261,21 +481,18 @@ void apply_damage_to_player(PlayerState* player, const DamageInfo* damage) {
     player->health -= (int)damage->amount;
     if (player->health < 0) player->health = 0;
     
-    printf("Player took %.1f damage! Health: %d/%d\n", 
-           damage->amount, player->health, player->max_health);
+    LOG_DEBUG(LOG_CATEGORY_GAMEPLAY, "Player took %.1f damage! Health: %d/%d", 
+              damage->amount, player->health, player->max_health);
     
-    // Play player hit sound
-    play_player_hit_sound();
-    
-    create_damage_effects(damage);
+    // Play player hit sound, unless this is a re-simulated hit
+    if (!rollback_is_resimulating()) {
+        play_player_hit_sound();
+        create_damage_effects(damage);
+    }
 }
 
 // Forward declarations for bridge functions
 extern void create_hit_effect_at_position(float x, float y, float z, int effect_type, float damage);
-extern void play_enemy_hit_sound(Vector3 position);
-extern void play_player_hit_sound();
-extern void play_enemy_death_sound(Vector3 position);
-extern void play_explosion_sound(Vector3 position);
 
 void create_damage_effects(const DamageInfo* damage) {
     if (!damage) return;
@@ -298,8 +515,8 @@ void create_damage_effects(const DamageInfo* damage) {
     create_hit_effect_at_position(damage->hit_point.x, damage->hit_point.y, damage->hit_point.z, 
                                  effect_type, damage->amount);
     
-    printf("Creating damage effects at (%.2f, %.2f, %.2f) - Damage: %.1f, Type: %d\n",
-           damage->hit_point.x, damage->hit_point.y, damage->hit_point.z, damage->amount, effect_type);
+    LOG_TRACE(LOG_CATEGORY_GRAPHICS, "Creating damage effects at (%.2f, %.2f, %.2f) - Damage: %.1f, Type: %d",
+              damage->hit_point.x, damage->hit_point.y, damage->hit_point.z, damage->amount, effect_type);
 }
 
 // Collision volumes for game objects
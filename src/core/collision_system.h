@@ -2,6 +2,7 @@
 #define COLLISION_SYSTEM_H
 
 #include "game_api.h"
+#include "arena.h"
 
 // Collision shapes
 typedef enum {
@@ -26,6 +27,7 @@ typedef struct {
     Vector3 hit_normal;
     float distance;
     float penetration_depth;
+    float time_of_impact; // Fraction along a swept path, 0 for static tests
 } CollisionResult;
 
 // Damage information
@@ -36,6 +38,24 @@ typedef struct {
     int damage_type; // 0 = bullet, 1 = explosion, 2 = melee
 } DamageInfo;
 
+// Spatial hash broadphase. Objects are bucketed by the cell containing
+// their center; queries widen their search by the largest inserted radius
+// so objects overlapping a cell boundary are still found.
+typedef struct {
+    float cell_size;
+    float inv_cell_size;
+    float max_radius;       // Largest radius inserted since the last clear
+    int bucket_mask;        // Bucket count - 1 (bucket count is a power of two)
+    int* bucket_heads;      // Bucket -> first entry, -1 when empty
+    int capacity;
+    int count;
+    int* next;              // Entry -> next entry in the same bucket
+    int* ids;               // Entry -> caller supplied id
+    int* cells;             // Entry -> cell coordinates (x, y, z triplets)
+    Vector3* centers;
+    float* radii;
+} SpatialHash;
+
 // Collision system functions
 void init_collision_system();
 void cleanup_collision_system();
@@ -45,10 +65,24 @@ CollisionResult check_sphere_sphere_collision(Vector3 pos1, float radius1, Vecto
 CollisionResult check_sphere_box_collision(Vector3 sphere_pos, float radius, Vector3 box_pos, Vector3 box_half_extents);
 CollisionResult check_ray_sphere_collision(Vector3 ray_origin, Vector3 ray_direction, Vector3 sphere_pos, float radius);
 CollisionResult check_ray_box_collision(Vector3 ray_origin, Vector3 ray_direction, Vector3 box_pos, Vector3 box_half_extents);
+// Sphere moving from start to end against a static sphere, reports the earliest contact
+CollisionResult check_swept_sphere_collision(Vector3 start, Vector3 end, float radius1, Vector3 pos2, float radius2);
+
+// Spatial hash broadphase - arrays are carved from the given arena, which
+// needs spatial_hash_storage_size() bytes for them
+size_t spatial_hash_storage_size(int capacity);
+int spatial_hash_init(SpatialHash* hash, float cell_size, int capacity, Arena* arena);
+void spatial_hash_clear(SpatialHash* hash);
+int spatial_hash_insert(SpatialHash* hash, int id, Vector3 center, float radius);
+// Writes the ids of objects whose spheres overlap the query sphere, returns the count written
+int spatial_hash_query_sphere(const SpatialHash* hash, Vector3 center, float radius, int* out_ids, int max_out);
 
 // Game-specific collision checks
 int check_projectile_enemy_collision(const Projectile* projectile, const Enemy* enemy, CollisionResult* result);
 int check_projectile_player_collision(const Projectile* projectile, const PlayerState* player, CollisionResult* result);
+// Swept variants test the whole step from previous_position to the projectile's current position
+int check_projectile_enemy_swept(const Projectile* projectile, Vector3 previous_position, const Enemy* enemy, CollisionResult* result);
+int check_projectile_player_swept(const Projectile* projectile, Vector3 previous_position, const PlayerState* player, CollisionResult* result);
 int check_enemy_player_collision(const Enemy* enemy, const PlayerState* player, CollisionResult* result);
 
 // Damage system
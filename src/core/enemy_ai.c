@@ -1,9 +1,10 @@
 #include "enemy_ai.h"
+#include "flow_field.h"
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
-void enemy_ai_init(EnemyAI* ai, EnemyType type) {
+void enemy_ai_init(EnemyAI* ai, EnemyAIType type) {
     memset(ai, 0, sizeof(EnemyAI));
     ai->type = type;
     ai->state = AI_STATE_IDLE;
@@ -64,9 +65,12 @@ void enemy_ai_update(EnemyAI* ai, Enemy* enemy, const PlayerState* player, float
             } else if (distance_to_player > ai->detection_range * 1.5f && !ai->is_player_visible) {
                 enemy_ai_set_state(ai, AI_STATE_IDLE);
             } else {
-                // Move towards player or last known position
-                Vector3 target = ai->is_player_visible ? player->position : ai->last_known_player_pos;
-                enemy_ai_move_towards_target(ai, enemy, target, delta_time);
+                // Path to a visible player through the shared flow field,
+                // otherwise head straight for the last known position
+                if (!ai->is_player_visible || !enemy_ai_follow_flow_field(ai, enemy, delta_time)) {
+                    Vector3 target = ai->is_player_visible ? player->position : ai->last_known_player_pos;
+                    enemy_ai_move_towards_target(ai, enemy, target, delta_time);
+                }
             }
             break;
             
@@ -87,7 +91,7 @@ void enemy_ai_update(EnemyAI* ai, Enemy* enemy, const PlayerState* player, float
     }
 }
 
-void enemy_ai_set_state(EnemyAI* ai, AIState new_state) {
+void enemy_ai_set_state(EnemyAI* ai, EnemyAIState new_state) {
     if (ai->state != new_state) {
         ai->state = new_state;
         
@@ -139,23 +143,32 @@ void enemy_ai_move_towards_target(EnemyAI* ai, Enemy* enemy, Vector3 target, flo
     }
 }
 
+int enemy_ai_follow_flow_field(EnemyAI* ai, Enemy* enemy, float delta_time) {
+    Vector3 direction;
+    if (!flow_field_sample(enemy->position, &direction)) {
+        return 0;
+    }
+    
+    float move_distance = ai->move_speed * delta_time;
+    enemy->position.x += direction.x * move_distance;
+    enemy->position.z += direction.z * move_distance;
+    
+    // Update velocity for physics
+    enemy->velocity.x = direction.x * ai->move_speed;
+    enemy->velocity.y = 0.0f;
+    enemy->velocity.z = direction.z * ai->move_speed;
+    return 1;
+}
+
 void enemy_ai_attack_player(EnemyAI* ai, Enemy* enemy, const PlayerState* player, float current_time) {
     if (current_time - ai->last_attack_time >= ai->attack_cooldown) {
-        // Create enemy projectile
-        Vector3 direction;
-        direction.x = player->position.x - enemy->position.x;
-        direction.y = player->position.y - enemy->position.y;
-        direction.z = player->position.z - enemy->position.z;
-        
-        // Normalize direction
-        float length = sqrtf(direction.x*direction.x + direction.y*direction.y + direction.z*direction.z);
-        if (length > 0.0f) {
-            direction.x /= length;
-            direction.y /= length;
-            direction.z /= length;
-            
-            // Create projectile (this would be handled by the object manager)
-            // For now, we'll just mark that an attack happened
+        // No shot when standing on the player, there is no direction to fire in
+        float dx = player->position.x - enemy->position.x;
+        float dy = player->position.y - enemy->position.y;
+        float dz = player->position.z - enemy->position.z;
+        if (dx*dx + dy*dy + dz*dz > 0.0f) {
+            // The object manager aims and spawns the projectile in its serial commit phase
+            ai->pending_attack = 1;
             ai->last_attack_time = current_time;
         }
     }
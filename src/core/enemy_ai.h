@@ -8,17 +8,17 @@ typedef enum {
     AI_STATE_CHASING,
     AI_STATE_ATTACKING,
     AI_STATE_DEAD
-} AIState;
+} EnemyAIState;
 
 typedef enum {
     ENEMY_TYPE_BASIC,
     ENEMY_TYPE_FAST,
     ENEMY_TYPE_HEAVY
-} EnemyType;
+} EnemyAIType;
 
-typedef struct {
-    AIState state;
-    EnemyType type;
+typedef struct EnemyAI {
+    EnemyAIState state;
+    EnemyAIType type;
     float detection_range;
     float attack_range;
     float move_speed;
@@ -29,14 +29,23 @@ typedef struct {
     Vector3 target_position;
     Vector3 last_known_player_pos;
     int is_player_visible;
+    int pending_attack;   // Set by the AI update, consumed by the object manager
+    
+    // LOD scheduling state owned by the object manager
+    float pending_dt;     // Time since the last AI update
+    int update_due;       // Waiting for a deferred update slot
 } EnemyAI;
 
 // AI system functions
-void enemy_ai_init(EnemyAI* ai, EnemyType type);
+// enemy_ai_update only writes to the given AI and enemy, so different enemies
+// can be updated in parallel. Side effects are reported through pending_attack.
+void enemy_ai_init(EnemyAI* ai, EnemyAIType type);
 void enemy_ai_update(EnemyAI* ai, Enemy* enemy, const PlayerState* player, float delta_time);
-void enemy_ai_set_state(EnemyAI* ai, AIState new_state);
+void enemy_ai_set_state(EnemyAI* ai, EnemyAIState new_state);
 int enemy_ai_can_see_player(const Enemy* enemy, const PlayerState* player);
 void enemy_ai_move_towards_target(EnemyAI* ai, Enemy* enemy, Vector3 target, float delta_time);
+// Step along the flow field towards the player, returns 0 if the field has no direction here
+int enemy_ai_follow_flow_field(EnemyAI* ai, Enemy* enemy, float delta_time);
 void enemy_ai_attack_player(EnemyAI* ai, Enemy* enemy, const PlayerState* player, float current_time);
 
 // Enemy type configurations
@@ -0,0 +1,98 @@
+#include "entity_pool.h"
+#include <string.h>
+
+// Generations live in the bits above the slot index and must keep the
+// handle positive, so they wrap before reaching the sign bit
+#define ENTITY_GENERATION_MAX ((1 << (31 - ENTITY_HANDLE_SLOT_BITS)) - 1)
+
+size_t entity_pool_storage_size(int capacity) {
+    return (size_t)capacity * 4 * sizeof(int);
+}
+
+void entity_pool_init(EntityPool* pool, int capacity, void* storage) {
+    if (!storage) {
+        capacity = 0;
+    } else if (capacity > MAX_ENTITY_CAPACITY) {
+        capacity = MAX_ENTITY_CAPACITY;
+    }
+    
+    int* ints = (int*)storage;
+    pool->capacity = capacity;
+    pool->free_slots = ints;
+    pool->alive = ints + capacity;
+    pool->alive_index = ints + capacity * 2;
+    pool->generations = ints + capacity * 3;
+    
+    // Generation 0 is never handed out, so a valid handle is never 0 or -1
+    for (int i = 0; i < capacity; i++) {
+        pool->generations[i] = 1;
+    }
+    
+    entity_pool_clear(pool);
+}
+
+void entity_pool_clear(EntityPool* pool) {
+    pool->count = 0;
+    pool->free_count = pool->capacity;
+    
+    // Push slots in reverse so the lowest slot is handed out first
+    for (int i = 0; i < pool->capacity; i++) {
+        pool->free_slots[i] = pool->capacity - 1 - i;
+        pool->alive_index[i] = -1;
+    }
+}
+
+int entity_pool_acquire(EntityPool* pool) {
+    if (pool->free_count <= 0) {
+        return INVALID_ENTITY_HANDLE;
+    }
+    
+    int slot = pool->free_slots[--pool->free_count];
+    
+    pool->alive_index[slot] = pool->count;
+    pool->alive[pool->count++] = slot;
+    
+    return (pool->generations[slot] << ENTITY_HANDLE_SLOT_BITS) | slot;
+}
+
+int entity_pool_release(EntityPool* pool, int handle) {
+    if (!entity_pool_is_valid(pool, handle)) {
+        return 0;
+    }
+    
+    int slot = entity_handle_slot(handle);
+    
+    // Swap the last live slot into the hole to keep the alive list dense
+    int index = pool->alive_index[slot];
+    int last_slot = pool->alive[--pool->count];
+    pool->alive[index] = last_slot;
+    pool->alive_index[last_slot] = index;
+    pool->alive_index[slot] = -1;
+    
+    // Invalidate outstanding handles to this slot
+    pool->generations[slot]++;
+    if (pool->generations[slot] > ENTITY_GENERATION_MAX) {
+        pool->generations[slot] = 1;
+    }
+    
+    pool->free_slots[pool->free_count++] = slot;
+    return 1;
+}
+
+int entity_pool_is_valid(const EntityPool* pool, int handle) {
+    if (handle < 0) {
+        return 0;
+    }
+    
+    int slot = entity_handle_slot(handle);
+    return slot < pool->capacity &&
+           pool->alive_index[slot] >= 0 &&
+           pool->generations[slot] == entity_handle_generation(handle);
+}
+
+int entity_pool_handle_for_slot(const EntityPool* pool, int slot) {
+    if (slot < 0 || slot >= pool->capacity || pool->alive_index[slot] < 0) {
+        return INVALID_ENTITY_HANDLE;
+    }
+    return (pool->generations[slot] << ENTITY_HANDLE_SLOT_BITS) | slot;
+}
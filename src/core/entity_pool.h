@@ -0,0 +1,30 @@
+#ifndef ENTITY_POOL_H
+#define ENTITY_POOL_H
+
+#include "game_api.h"
+#include <stddef.h>
+
+// Storage needed by a pool of the given capacity (four int arrays)
+size_t entity_pool_storage_size(int capacity);
+
+// Pool setup - storage must stay valid for the lifetime of the pool
+void entity_pool_init(EntityPool* pool, int capacity, void* storage);
+void entity_pool_clear(EntityPool* pool);
+
+// Slot allocation, both O(1)
+int entity_pool_acquire(EntityPool* pool);
+int entity_pool_release(EntityPool* pool, int handle);
+
+// Handle queries
+int entity_pool_is_valid(const EntityPool* pool, int handle);
+int entity_pool_handle_for_slot(const EntityPool* pool, int slot);
+
+static inline int entity_handle_slot(int handle) {
+    return handle & ENTITY_HANDLE_SLOT_MASK;
+}
+
+static inline int entity_handle_generation(int handle) {
+    return handle >> ENTITY_HANDLE_SLOT_BITS;
+}
+
+#endif // ENTITY_POOL_H
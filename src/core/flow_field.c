@@ -0,0 +1,371 @@
+#include "flow_field.h"
+#include <stdio.h>
+#include <string.h>
+
+#define FLOW_FIELD_CELLS (FLOW_FIELD_SIZE * FLOW_FIELD_SIZE)
+#define FLOW_FIELD_UNREACHABLE 0xFFFFFFFFu
+#define FLOW_FIELD_NO_DIRECTION -1
+
+// Octile step costs, a diagonal step costs sqrt(2) times an orthogonal one
+#define FLOW_FIELD_ORTHOGONAL_COST 10
+#define FLOW_FIELD_DIAGONAL_COST 14
+
+// Neighbour offsets: four orthogonal directions first, then the diagonals
+static const int g_offset_x[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+static const int g_offset_z[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+static const float g_direction_x[8] = {1.0f, -1.0f, 0.0f, 0.0f, 0.70710678f, 0.70710678f, -0.70710678f, -0.70710678f};
+static const float g_direction_z[8] = {0.0f, 0.0f, 1.0f, -1.0f, 0.70710678f, -0.70710678f, 0.70710678f, -0.70710678f};
+
+// A rebuild is spread over FLOW_FIELD_BUILD_TICKS updates and published at
+// the end of the last one, so no tick pays for a whole Dijkstra pass. The
+// integration pass gets at most six updates and the direction pass two.
+#define FLOW_FIELD_BUILD_TICKS 8
+#define FLOW_FIELD_INTEGRATION_BUDGET ((FLOW_FIELD_CELLS + 5) / 6)
+#define FLOW_FIELD_DIRECTION_BUDGET ((FLOW_FIELD_CELLS + 1) / 2)
+
+typedef enum {
+    FLOW_FIELD_STAGE_IDLE,
+    FLOW_FIELD_STAGE_INTEGRATION,
+    FLOW_FIELD_STAGE_DIRECTIONS,
+    FLOW_FIELD_STAGE_DONE
+} FlowFieldStage;
+
+static unsigned char g_blocked[FLOW_FIELD_CELLS];
+static unsigned int g_integration[FLOW_FIELD_CELLS];
+
+// Published direction field and the one being built, swapped on publish
+static signed char g_direction_buffers[2][FLOW_FIELD_CELLS];
+static signed char* g_direction = g_direction_buffers[0];
+static signed char* g_build_direction = g_direction_buffers[1];
+
+// Binary min-heap of open cells keyed by integration cost, with each cell's
+// heap position so a cheaper path can move it up in place
+static int g_heap[FLOW_FIELD_CELLS];
+static int g_heap_position[FLOW_FIELD_CELLS];
+static int g_heap_count = 0;
+
+// Rebuild schedule, saved with snapshots so a re-simulated tick publishes
+// the same field on the same tick
+static int g_target_cell = -1;          // Cell the published field leads to, -1 when none
+static int g_build_target = -1;         // Cell being built, -1 when idle
+static int g_build_ticks_left = 0;      // Updates until the build is published
+static int g_dirty = 1;
+
+// What the buffers actually hold. This is a cache of the schedule: after a
+// rollback whatever it lacks is rebuilt from the schedule.
+static int g_field_cell = -1;           // Cell g_direction was built for
+static int g_work_target = -1;          // Cell the build buffers are working on
+static FlowFieldStage g_work_stage = FLOW_FIELD_STAGE_IDLE;
+static int g_work_cell = 0;             // Next cell of the direction pass
+
+static void reset_flow_field_state() {
+    memset(g_direction_buffers, FLOW_FIELD_NO_DIRECTION, sizeof(g_direction_buffers));
+    g_direction = g_direction_buffers[0];
+    g_build_direction = g_direction_buffers[1];
+    g_target_cell = -1;
+    g_build_target = -1;
+    g_build_ticks_left = 0;
+    g_dirty = 1;
+    g_field_cell = -1;
+    g_work_target = -1;
+    g_work_stage = FLOW_FIELD_STAGE_IDLE;
+    g_work_cell = 0;
+}
+
+void init_flow_field() {
+    memset(g_blocked, 0, sizeof(g_blocked));
+    memset(g_integration, 0xff, sizeof(g_integration));
+    reset_flow_field_state();
+    
+    printf("Flow field initialized (%dx%d cells)\n", FLOW_FIELD_SIZE, FLOW_FIELD_SIZE);
+}
+
+void cleanup_flow_field() {
+    reset_flow_field_state();
+    printf("Flow field cleaned up\n");
+}
+
+void flow_field_set_blocked(int cell_x, int cell_z, int blocked) {
+    if (cell_x < 0 || cell_x >= FLOW_FIELD_SIZE || cell_z < 0 || cell_z >= FLOW_FIELD_SIZE) {
+        return;
+    }
+    
+    g_blocked[cell_z * FLOW_FIELD_SIZE + cell_x] = blocked ? 1 : 0;
+    g_dirty = 1;
+    g_work_target = -1;
+}
+
+void flow_field_block_area(Vector3 min, Vector3 max) {
+    float half_extent = FLOW_FIELD_SIZE * FLOW_FIELD_CELL_SIZE * 0.5f;
+    int min_x = (int)((min.x + half_extent) / FLOW_FIELD_CELL_SIZE);
+    int min_z = (int)((min.z + half_extent) / FLOW_FIELD_CELL_SIZE);
+    int max_x = (int)((max.x + half_extent) / FLOW_FIELD_CELL_SIZE);
+    int max_z = (int)((max.z + half_extent) / FLOW_FIELD_CELL_SIZE);
+    
+    for (int z = min_z; z <= max_z; z++) {
+        for (int x = min_x; x <= max_x; x++) {
+            flow_field_set_blocked(x, z, 1);
+        }
+    }
+}
+
+void flow_field_clear_blocked() {
+    memset(g_blocked, 0, sizeof(g_blocked));
+    g_dirty = 1;
+    g_work_target = -1;
+}
+
+int flow_field_world_to_cell(Vector3 position, int* cell_x, int* cell_z) {
+    float half_extent = FLOW_FIELD_SIZE * FLOW_FIELD_CELL_SIZE * 0.5f;
+    float fx = (position.x + half_extent) / FLOW_FIELD_CELL_SIZE;
+    float fz = (position.z + half_extent) / FLOW_FIELD_CELL_SIZE;
+    
+    if (fx < 0.0f || fz < 0.0f || fx >= FLOW_FIELD_SIZE || fz >= FLOW_FIELD_SIZE) {
+        return 0;
+    }
+    
+    *cell_x = (int)fx;
+    *cell_z = (int)fz;
+    return 1;
+}
+
+// Diagonal steps may not squeeze between two blocked orthogonal cells
+static int flow_field_corner_blocked(int x, int z, int nx, int nz) {
+    return g_blocked[z * FLOW_FIELD_SIZE + nx] || g_blocked[nz * FLOW_FIELD_SIZE + x];
+}
+
+static void heap_swap(int a, int b) {
+    int cell_a = g_heap[a];
+    int cell_b = g_heap[b];
+    g_heap[a] = cell_b;
+    g_heap[b] = cell_a;
+    g_heap_position[cell_b] = a;
+    g_heap_position[cell_a] = b;
+}
+
+static void heap_sift_up(int index) {
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (g_integration[g_heap[parent]] <= g_integration[g_heap[index]]) break;
+        heap_swap(parent, index);
+        index = parent;
+    }
+}
+
+static void heap_sift_down(int index) {
+    for (;;) {
+        int smallest = index;
+        int left = index * 2 + 1;
+        int right = left + 1;
+        if (left < g_heap_count && g_integration[g_heap[left]] < g_integration[g_heap[smallest]]) smallest = left;
+        if (right < g_heap_count && g_integration[g_heap[right]] < g_integration[g_heap[smallest]]) smallest = right;
+        if (smallest == index) break;
+        heap_swap(smallest, index);
+        index = smallest;
+    }
+}
+
+static int heap_pop() {
+    int cell = g_heap[0];
+    g_heap_position[cell] = -1;
+    g_heap_count--;
+    if (g_heap_count > 0) {
+        g_heap[0] = g_heap[g_heap_count];
+        g_heap_position[g_heap[0]] = 0;
+        heap_sift_down(0);
+    }
+    return cell;
+}
+
+// Lower a cell's cost, inserting it into the heap if it is not there yet
+static void heap_decrease(int cell, unsigned int cost) {
+    g_integration[cell] = cost;
+    if (g_heap_position[cell] < 0) {
+        g_heap[g_heap_count] = cell;
+        g_heap_position[cell] = g_heap_count;
+        g_heap_count++;
+    }
+    heap_sift_up(g_heap_position[cell]);
+}
+
+// Dijkstra integration field from the target cell over eight neighbours,
+// so costs follow octile distance and diagonal shortcuts are real paths
+static void begin_integration_field(int target_cell) {
+    memset(g_integration, 0xff, sizeof(g_integration));
+    memset(g_heap_position, 0xff, sizeof(g_heap_position));
+    g_heap_count = 0;
+    if (!g_blocked[target_cell]) {
+        heap_decrease(target_cell, 0);
+    }
+}
+
+// Settle up to budget cells, returns 1 once every reachable cell is settled
+static int step_integration_field(int budget) {
+    while (g_heap_count > 0 && budget-- > 0) {
+        int cell = heap_pop();
+        int x = cell % FLOW_FIELD_SIZE;
+        int z = cell / FLOW_FIELD_SIZE;
+        
+        for (int i = 0; i < 8; i++) {
+            int nx = x + g_offset_x[i];
+            int nz = z + g_offset_z[i];
+            if (nx < 0 || nx >= FLOW_FIELD_SIZE || nz < 0 || nz >= FLOW_FIELD_SIZE) continue;
+            if (i >= 4 && flow_field_corner_blocked(x, z, nx, nz)) continue;
+            
+            int neighbour = nz * FLOW_FIELD_SIZE + nx;
+            if (g_blocked[neighbour]) continue;
+            
+            unsigned int cost = g_integration[cell] + (i < 4 ? FLOW_FIELD_ORTHOGONAL_COST : FLOW_FIELD_DIAGONAL_COST);
+            if (cost < g_integration[neighbour]) {
+                heap_decrease(neighbour, cost);
+            }
+        }
+    }
+    return g_heap_count == 0;
+}
+
+// Point cells [first, last) along their shortest path: at the neighbour
+// whose cost plus the step to it is lowest, without cutting blocked corners
+static void build_direction_range(int first, int last) {
+    for (int cell = first; cell < last; cell++) {
+        int x = cell % FLOW_FIELD_SIZE;
+        int z = cell / FLOW_FIELD_SIZE;
+        int best = FLOW_FIELD_NO_DIRECTION;
+        unsigned int best_cost = FLOW_FIELD_UNREACHABLE;
+        
+        if (g_integration[cell] == FLOW_FIELD_UNREACHABLE || g_integration[cell] == 0) {
+            g_build_direction[cell] = FLOW_FIELD_NO_DIRECTION;
+            continue;
+        }
+        
+        for (int i = 0; i < 8; i++) {
+            int nx = x + g_offset_x[i];
+            int nz = z + g_offset_z[i];
+            if (nx < 0 || nx >= FLOW_FIELD_SIZE || nz < 0 || nz >= FLOW_FIELD_SIZE) continue;
+            
+            if (i >= 4 && flow_field_corner_blocked(x, z, nx, nz)) {
+                continue;
+            }
+            
+            unsigned int cost = g_integration[nz * FLOW_FIELD_SIZE + nx];
+            if (cost == FLOW_FIELD_UNREACHABLE) continue;
+            
+            cost += i < 4 ? FLOW_FIELD_ORTHOGONAL_COST : FLOW_FIELD_DIAGONAL_COST;
+            if (cost < best_cost) {
+                best_cost = cost;
+                best = i;
+            }
+        }
+        
+        g_build_direction[cell] = (signed char)best;
+    }
+}
+
+static void begin_build(int target_cell) {
+    begin_integration_field(target_cell);
+    g_work_target = target_cell;
+    g_work_stage = FLOW_FIELD_STAGE_INTEGRATION;
+    g_work_cell = 0;
+}
+
+// One update's share of the build, or the whole rest of it when unbounded
+static void step_build(int unbounded) {
+    if (g_work_stage == FLOW_FIELD_STAGE_INTEGRATION) {
+        if (step_integration_field(unbounded ? FLOW_FIELD_CELLS : FLOW_FIELD_INTEGRATION_BUDGET)) {
+            g_work_stage = FLOW_FIELD_STAGE_DIRECTIONS;
+        }
+        if (!unbounded) return;
+    }
+    
+    if (g_work_stage == FLOW_FIELD_STAGE_DIRECTIONS) {
+        int last = unbounded ? FLOW_FIELD_CELLS : g_work_cell + FLOW_FIELD_DIRECTION_BUDGET;
+        if (last > FLOW_FIELD_CELLS) last = FLOW_FIELD_CELLS;
+        build_direction_range(g_work_cell, last);
+        g_work_cell = last;
+        if (g_work_cell == FLOW_FIELD_CELLS) {
+            g_work_stage = FLOW_FIELD_STAGE_DONE;
+        }
+    }
+}
+
+static void publish_build() {
+    step_build(1);
+    
+    signed char* published = g_build_direction;
+    g_build_direction = g_direction;
+    g_direction = published;
+    g_field_cell = g_work_target;
+    g_work_target = -1;
+    g_work_stage = FLOW_FIELD_STAGE_IDLE;
+}
+
+void flow_field_update(Vector3 target) {
+    int cell_x, cell_z;
+    if (!flow_field_world_to_cell(target, &cell_x, &cell_z)) {
+        // Target left the grid, enemies fall back to direct movement
+        g_target_cell = -1;
+        g_build_target = -1;
+        return;
+    }
+    
+    // Start a build when the target moved to another cell or obstacles
+    // changed. A move during a build is picked up once it is published.
+    int target_cell = cell_z * FLOW_FIELD_SIZE + cell_x;
+    if (g_build_target < 0 && (target_cell != g_target_cell || g_dirty)) {
+        g_build_target = target_cell;
+        g_build_ticks_left = FLOW_FIELD_BUILD_TICKS;
+        g_dirty = 0;
+    }
+    if (g_build_target < 0) {
+        return;
+    }
+    
+    if (g_work_target != g_build_target) {
+        begin_build(g_build_target);
+    }
+    step_build(0);
+    
+    if (--g_build_ticks_left == 0) {
+        publish_build();
+        g_target_cell = g_build_target;
+        g_build_target = -1;
+    }
+}
+
+void save_flow_field_snapshot(FlowFieldSnapshot* snapshot) {
+    snapshot->target_cell = g_target_cell;
+    snapshot->build_target = g_build_target;
+    snapshot->build_ticks_left = g_build_ticks_left;
+}
+
+void load_flow_field_snapshot(const FlowFieldSnapshot* snapshot) {
+    g_target_cell = snapshot->target_cell;
+    g_build_target = snapshot->build_target;
+    g_build_ticks_left = snapshot->build_ticks_left;
+    
+    // A rollback across a publish needs the older field back. A pending
+    // build restarts on the next update if its buffers were used for that.
+    if (g_target_cell >= 0 && g_field_cell != g_target_cell) {
+        if (g_work_target != g_target_cell) {
+            begin_build(g_target_cell);
+        }
+        publish_build();
+    }
+}
+
+int flow_field_sample(Vector3 position, Vector3* direction) {
+    int cell_x, cell_z;
+    if (g_target_cell < 0 || !flow_field_world_to_cell(position, &cell_x, &cell_z)) {
+        return 0;
+    }
+    
+    int index = g_direction[cell_z * FLOW_FIELD_SIZE + cell_x];
+    if (index == FLOW_FIELD_NO_DIRECTION) {
+        return 0;
+    }
+    
+    direction->x = g_direction_x[index];
+    direction->y = 0.0f;
+    direction->z = g_direction_z[index];
+    return 1;
+}
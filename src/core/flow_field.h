@@ -0,0 +1,45 @@
+#ifndef FLOW_FIELD_H
+#define FLOW_FIELD_H
+
+#include "game_api.h"
+
+// Flow field over a square grid on the XZ plane, centered on the origin.
+// One field is shared by every enemy heading for the same target: an
+// integration field holds each cell's octile path distance to the target
+// (diagonal steps cost sqrt(2)) and a direction field points every cell
+// along its shortest path.
+#define FLOW_FIELD_SIZE 100
+#define FLOW_FIELD_CELL_SIZE 1.0f
+
+void init_flow_field();
+void cleanup_flow_field();
+
+// Obstacles - changes take effect on the next flow_field_update()
+void flow_field_set_blocked(int cell_x, int cell_z, int blocked);
+void flow_field_block_area(Vector3 min, Vector3 max);
+void flow_field_clear_blocked();
+
+// Returns 0 when the position lies outside the grid
+int flow_field_world_to_cell(Vector3 position, int* cell_x, int* cell_z);
+
+// Call once per tick. When the target moved to another cell or obstacles
+// changed, a rebuild starts and is spread over the next few calls; the
+// previous field stays in use until the new one is published whole.
+void flow_field_update(Vector3 target);
+
+// Rebuild schedule, part of the simulation state. The field itself is
+// recomputed from it when a rollback needs an older one.
+typedef struct {
+    int target_cell;
+    int build_target;
+    int build_ticks_left;
+} FlowFieldSnapshot;
+
+void save_flow_field_snapshot(FlowFieldSnapshot* snapshot);
+void load_flow_field_snapshot(const FlowFieldSnapshot* snapshot);
+
+// O(1) lookup of the normalized XZ direction to follow from a position.
+// Returns 0 outside the grid, in the target cell or where the target is unreachable.
+int flow_field_sample(Vector3 position, Vector3* direction);
+
+#endif // FLOW_FIELD_H
@@ -0,0 +1,273 @@
+#include "frame_stats.h"
+#include "atomics.h"
+#include <stdio.h>
+#include <string.h>
+
+// Values are whole microseconds. Below 2^SUB_BITS every value has its own
+// bucket, above that each power of two is split into 2^SUB_BITS buckets,
+// so a bucket is never wider than 1/64 of its value.
+#define FRAME_STATS_SUB_BITS 6
+#define FRAME_STATS_SUB_COUNT (1 << FRAME_STATS_SUB_BITS)
+#define FRAME_STATS_MAX_BITS 26 // Values clamp just below 2^26 us (~67 s)
+#define FRAME_STATS_MAX_VALUE ((1u << FRAME_STATS_MAX_BITS) - 1)
+#define FRAME_STATS_BUCKET_COUNT ((FRAME_STATS_MAX_BITS - FRAME_STATS_SUB_BITS + 1) * FRAME_STATS_SUB_COUNT)
+#define FRAME_STATS_PATH_LENGTH 260
+
+typedef struct {
+    unsigned int buckets[FRAME_STATS_BUCKET_COUNT];
+    unsigned int count;
+    double total;   // Seconds
+    double max;     // Seconds
+    unsigned int hitches[FRAME_STATS_MAX_HITCH_THRESHOLDS];
+} FrameHistogram;
+
+typedef struct {
+    FrameHistogram session[FRAME_STAT_COUNT];
+    FrameHistogram window[FRAME_STAT_COUNT];
+    FrameStatsSummary recent[FRAME_STAT_COUNT];
+    int has_recent;
+    double window_elapsed;
+} FrameStatsState;
+
+static FrameStatsState g_frame_stats;
+static volatile int32_t g_frame_stats_lock;
+
+static char g_csv_path[FRAME_STATS_PATH_LENGTH] = DEFAULT_FRAME_STATS_FILE;
+static float g_hitch_thresholds[FRAME_STATS_MAX_HITCH_THRESHOLDS] = { 25.0f, 50.0f, 100.0f };
+static int g_hitch_threshold_count = 3;
+
+static const char* g_stat_names[FRAME_STAT_COUNT] = { "frame", "simulation", "render" };
+
+// Held for a histogram update or a summary, never contended for long
+static void frame_stats_lock() {
+    while (!atomic_cas_i32(&g_frame_stats_lock, 0, 1)) {
+    }
+}
+
+static void frame_stats_unlock() {
+    atomic_store_i32(&g_frame_stats_lock, 0);
+}
+
+static int bucket_index(unsigned int value) {
+    if (value < FRAME_STATS_SUB_COUNT) {
+        return (int)value;
+    }
+    
+    int msb = FRAME_STATS_SUB_BITS;
+    while ((value >> (msb + 1)) != 0) {
+        msb++;
+    }
+    int shift = msb - FRAME_STATS_SUB_BITS;
+    return shift * FRAME_STATS_SUB_COUNT + (int)(value >> shift);
+}
+
+// Midpoint of a bucket in microseconds
+static double bucket_value(int index) {
+    if (index < 2 * FRAME_STATS_SUB_COUNT) {
+        return (double)index;
+    }
+    
+    int shift = index / FRAME_STATS_SUB_COUNT - 1;
+    unsigned int lower = (unsigned int)(index - shift * FRAME_STATS_SUB_COUNT) << shift;
+    return lower + ((1u << shift) - 1) * 0.5;
+}
+
+static void histogram_record(FrameHistogram* histogram, double seconds) {
+    double microseconds = seconds * 1000000.0 + 0.5;
+    unsigned int value = microseconds >= FRAME_STATS_MAX_VALUE ? FRAME_STATS_MAX_VALUE : (unsigned int)microseconds;
+    
+    histogram->buckets[bucket_index(value)]++;
+    histogram->count++;
+    histogram->total += seconds;
+    if (seconds > histogram->max) {
+        histogram->max = seconds;
+    }
+    
+    double milliseconds = seconds * 1000.0;
+    for (int i = 0; i < g_hitch_threshold_count; i++) {
+        if (milliseconds > g_hitch_thresholds[i]) {
+            histogram->hitches[i]++;
+        }
+    }
+}
+
+static float histogram_percentile_ms(const FrameHistogram* histogram, double percentile) {
+    if (histogram->count == 0) {
+        return 0.0f;
+    }
+    
+    // Smallest value that covers the requested share of samples
+    unsigned int rank = (unsigned int)(percentile / 100.0 * histogram->count + 0.999999);
+    if (rank < 1) rank = 1;
+    
+    unsigned int seen = 0;
+    for (int i = 0; i < FRAME_STATS_BUCKET_COUNT; i++) {
+        seen += histogram->buckets[i];
+        if (seen >= rank) {
+            // Never report more than the exact maximum
+            double value_ms = bucket_value(i) / 1000.0;
+            double max_ms = histogram->max * 1000.0;
+            return (float)(value_ms < max_ms ? value_ms : max_ms);
+        }
+    }
+    return (float)(histogram->max * 1000.0);
+}
+
+static void summarize(const FrameHistogram* histogram, FrameStatsSummary* summary) {
+    memset(summary, 0, sizeof(FrameStatsSummary));
+    summary->samples = histogram->count;
+    if (histogram->count > 0) {
+        summary->mean_ms = (float)(histogram->total * 1000.0 / histogram->count);
+    }
+    summary->p50_ms = histogram_percentile_ms(histogram, 50.0);
+    summary->p95_ms = histogram_percentile_ms(histogram, 95.0);
+    summary->p99_ms = histogram_percentile_ms(histogram, 99.0);
+    summary->p999_ms = histogram_percentile_ms(histogram, 99.9);
+    summary->max_ms = (float)(histogram->max * 1000.0);
+    
+    summary->hitch_threshold_count = g_hitch_threshold_count;
+    for (int i = 0; i < g_hitch_threshold_count; i++) {
+        summary->hitch_threshold_ms[i] = g_hitch_thresholds[i];
+        summary->hitches[i] = histogram->hitches[i];
+    }
+}
+
+// Frame time drives the RECENT window, the other stats close with it
+static void roll_window() {
+    for (int stat = 0; stat < FRAME_STAT_COUNT; stat++) {
+        summarize(&g_frame_stats.window[stat], &g_frame_stats.recent[stat]);
+    }
+    memset(g_frame_stats.window, 0, sizeof(g_frame_stats.window));
+    g_frame_stats.has_recent = 1;
+    g_frame_stats.window_elapsed = 0.0;
+}
+
+void init_frame_stats() {
+    memset(&g_frame_stats, 0, sizeof(FrameStatsState));
+    printf("Frame stats initialized - hitch thresholds:");
+    for (int i = 0; i < g_hitch_threshold_count; i++) {
+        printf(" %.1fms", g_hitch_thresholds[i]);
+    }
+    printf("\n");
+}
+
+void frame_stats_set_csv_path(const char* path) {
+    if (path) {
+        snprintf(g_csv_path, FRAME_STATS_PATH_LENGTH, "%s", path);
+    } else {
+        g_csv_path[0] = '\0';
+    }
+}
+
+void frame_stats_set_hitch_thresholds(const float* thresholds_ms, int count) {
+    if (count > FRAME_STATS_MAX_HITCH_THRESHOLDS) {
+        count = FRAME_STATS_MAX_HITCH_THRESHOLDS;
+    }
+    
+    frame_stats_lock();
+    g_hitch_threshold_count = 0;
+    for (int i = 0; i < count; i++) {
+        if (thresholds_ms[i] > 0.0f) {
+            g_hitch_thresholds[g_hitch_threshold_count++] = thresholds_ms[i];
+        }
+    }
+    
+    // Counts so far were taken against the old thresholds
+    memset(&g_frame_stats, 0, sizeof(FrameStatsState));
+    frame_stats_unlock();
+}
+
+void frame_stats_record(FrameStat stat, double seconds) {
+    if ((int)stat < 0 || stat >= FRAME_STAT_COUNT || seconds < 0.0) {
+        return;
+    }
+    
+    frame_stats_lock();
+    histogram_record(&g_frame_stats.session[stat], seconds);
+    histogram_record(&g_frame_stats.window[stat], seconds);
+    
+    if (stat == FRAME_STAT_FRAME) {
+        g_frame_stats.window_elapsed += seconds;
+        if (g_frame_stats.window_elapsed >= FRAME_STATS_WINDOW_SECONDS) {
+            roll_window();
+        }
+    }
+    frame_stats_unlock();
+}
+
+void frame_stats_reset() {
+    frame_stats_lock();
+    memset(&g_frame_stats, 0, sizeof(FrameStatsState));
+    frame_stats_unlock();
+}
+
+int frame_stats_get_summary(int stat, int scope, FrameStatsSummary* summary) {
+    if (stat < 0 || stat >= FRAME_STAT_COUNT || !summary) {
+        return 0;
+    }
+    
+    int found = 1;
+    frame_stats_lock();
+    switch (scope) {
+        case FRAME_STATS_RECENT:
+            if (g_frame_stats.has_recent) {
+                *summary = g_frame_stats.recent[stat];
+            } else {
+                summarize(&g_frame_stats.window[stat], summary);
+            }
+            break;
+            
+        case FRAME_STATS_SESSION:
+            summarize(&g_frame_stats.session[stat], summary);
+            break;
+            
+        default:
+            found = 0;
+            break;
+    }
+    frame_stats_unlock();
+    return found;
+}
+
+int frame_stats_write_csv(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        printf("Frame stats: cannot open %s for writing\n", path);
+        return 0;
+    }
+    
+    fprintf(file, "stat,samples,mean_ms,p50_ms,p95_ms,p99_ms,p99_9_ms,max_ms");
+    for (int i = 0; i < g_hitch_threshold_count; i++) {
+        fprintf(file, ",hitches_over_%gms", g_hitch_thresholds[i]);
+    }
+    fprintf(file, "\n");
+    
+    for (int stat = 0; stat < FRAME_STAT_COUNT; stat++) {
+        FrameStatsSummary summary;
+        frame_stats_get_summary(stat, FRAME_STATS_SESSION, &summary);
+        
+        fprintf(file, "%s,%u,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f", g_stat_names[stat], summary.samples,
+                summary.mean_ms, summary.p50_ms, summary.p95_ms, summary.p99_ms, summary.p999_ms,
+                summary.max_ms);
+        for (int i = 0; i < summary.hitch_threshold_count; i++) {
+            fprintf(file, ",%u", summary.hitches[i]);
+        }
+        fprintf(file, "\n");
+    }
+    
+    fclose(file);
+    return 1;
+}
+
+const char* frame_stat_name(FrameStat stat) {
+    if ((int)stat < 0 || stat >= FRAME_STAT_COUNT) {
+        return "unknown";
+    }
+    return g_stat_names[stat];
+}
+
+void cleanup_frame_stats() {
+    if (g_csv_path[0] != '\0' && frame_stats_write_csv(g_csv_path)) {
+        printf("Frame stats written to %s\n", g_csv_path);
+    }
+}
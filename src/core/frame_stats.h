@@ -0,0 +1,65 @@
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Frame time distributions kept in log-linear (HDR-style) histograms with
+// under 1% value error from 1 us to ~67 s. Percentiles come from the
+// histogram, max, mean and hitch counts are exact. Recording and queries
+// are safe from any thread (the simulation thread records its own time).
+
+#define FRAME_STATS_MAX_HITCH_THRESHOLDS 4
+#define FRAME_STATS_WINDOW_SECONDS 5.0  // Length of the RECENT window
+#define DEFAULT_FRAME_STATS_FILE "frame_stats.csv"
+
+typedef enum {
+    FRAME_STAT_FRAME,       // Start of one frame to the start of the next
+    FRAME_STAT_SIMULATION,  // One batch of ticks (per frame, per tick headless, per wakeup threaded)
+    FRAME_STAT_RENDER,      // World and UI rendering
+    FRAME_STAT_COUNT
+} FrameStat;
+
+typedef enum {
+    FRAME_STATS_RECENT,     // Last completed window (the running one until the first completes)
+    FRAME_STATS_SESSION     // Everything since init or the last reset
+} FrameStatsScope;
+
+// Mirrored by FrameStatsSummary in UIManager.cs
+typedef struct {
+    unsigned int samples;
+    float mean_ms;
+    float p50_ms;
+    float p95_ms;
+    float p99_ms;
+    float p999_ms;
+    float max_ms;
+    int hitch_threshold_count;
+    float hitch_threshold_ms[FRAME_STATS_MAX_HITCH_THRESHOLDS];
+    unsigned int hitches[FRAME_STATS_MAX_HITCH_THRESHOLDS]; // Samples above each threshold
+} FrameStatsSummary;
+
+void init_frame_stats();
+void cleanup_frame_stats(); // Writes the session CSV unless disabled
+
+// Configuration, kept across init and cleanup
+void frame_stats_set_csv_path(const char* path); // NULL disables the CSV
+void frame_stats_set_hitch_thresholds(const float* thresholds_ms, int count);
+
+void frame_stats_record(FrameStat stat, double seconds);
+void frame_stats_reset();
+
+// Returns 0 for an unknown stat or scope
+int frame_stats_get_summary(int stat, int scope, FrameStatsSummary* summary);
+
+// One row per stat with the session summary, returns 0 on failure
+int frame_stats_write_csv(const char* path);
+
+const char* frame_stat_name(FrameStat stat);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FRAME_STATS_H
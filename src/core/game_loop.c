@@ -5,6 +5,17 @@
 #include "game_state.h"
 #include "input_manager.h"
 #include "object_manager.h"
+#include "job_system.h"
+#include "timer.h"
+#include "log.h"
+#include "trace.h"
+#include "frame_stats.h"
+#include "sim_thread.h"
+#include "replay.h"
+#include "rng.h"
+#include "rollback.h"
+#include "alloc_counter.h"
+#include "arena.h"
 #include "../graphics_bridge.h"
 #include "../physics_bridge.h"
 #include "../ui_bridge.h"
@@ -12,55 +23,77 @@
 #include <stdio.h>
 #include <time.h>
 #include <stdlib.h>
+#include <math.h>
+#include <string.h>
 
-#ifdef _WIN32
-#include <windows.h>
-#else
-#include <unistd.h>
-#include <sys/time.h>
-#endif
+// Headless runs with rollback on rewind this often to check determinism
+#define HEADLESS_ROLLBACK_INTERVAL 16
 
-static GameLoop g_game_loop;
+// Headless ticks before heap allocations count, buffers reach their working size by then
+#define HEADLESS_WARMUP_TICKS SIMULATION_TICK_RATE
 
-// Cross-platform time functions
-static double get_current_time() {
-#ifdef _WIN32
-    LARGE_INTEGER frequency;
-    LARGE_INTEGER counter;
-    QueryPerformanceFrequency(&frequency);
-    QueryPerformanceCounter(&counter);
-    return (double)counter.QuadPart / (double)frequency.QuadPart;
-#else
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return tv.tv_sec + tv.tv_usec / 1000000.0;
-#endif
-}
+static GameLoop g_game_loop;
+static int g_job_workers = -1;
+static int g_headless = 0;
+static int g_sim_thread_mode = -1;
+static const char* g_record_file = NULL;
+static unsigned int g_random_seed = 0;
+static int g_random_seed_set = 0;
+static int g_rollback_window = 0;
+static SimulationTimings g_sim_timings;
+static float g_game_over_timer = 0.0f;
+static GamePhase g_music_phase = GAME_MENU;
 
-static void sleep_ms(int milliseconds) {
-#ifdef _WIN32
-    Sleep(milliseconds);
-#else
-    usleep(milliseconds * 1000);
-#endif
+// Automatic mode only pays for the extra thread when there is a core to run it on
+static int use_sim_thread() {
+    if (g_sim_thread_mode >= 0) {
+        return g_sim_thread_mode;
+    }
+    return job_system_thread_count() > 1;
 }
 
-void init_core_engine() {
+int init_core_engine() {
     printf("Initializing Core Engine...\n");
     
     // Initialize game loop structure
     g_game_loop.last_time = get_current_time();
     g_game_loop.current_time = g_game_loop.last_time;
     g_game_loop.delta_time = 0.0;
+    g_game_loop.accumulator = 0.0;
+    g_game_loop.tick_count = 0;
     g_game_loop.target_fps = 60;
     
     // Initialize subsystems
+    init_timer();
+    init_log();
+    init_trace();
+    init_frame_stats();
+    if (!init_transient_arenas()) {
+        printf("Error: Failed to allocate transient arenas\n");
+        cleanup_frame_stats();
+        cleanup_trace();
+        cleanup_log();
+        cleanup_timer();
+        return 0;
+    }
+    
+    // Seed the random streams before anything draws from them, a replay
+    // needs the seed it was recorded with
+    unsigned int seed = g_random_seed_set ? g_random_seed : (unsigned int)time(NULL);
+    if (replay_is_playing()) {
+        seed = replay_get_header()->seed;
+    }
+    init_rng(seed);
+    
+    init_job_system(g_job_workers);
     init_game_state();
     init_input_manager();
     init_object_manager();
     
     // Initialize graphics engine
-    if (!init_graphics_engine()) {
+    if (g_headless) {
+        printf("Headless mode: graphics, UI and audio disabled\n");
+    } else if (!init_graphics_engine()) {
         printf("Warning: Graphics engine initialization failed - running in text mode\n");
     }
     
@@ -80,20 +113,39 @@ void init_core_engine() {
         printf("Bunny hop mechanics ready!\n");
     }
     
-    // Initialize UI manager
-    if (!init_ui_manager()) {
-        printf("Warning: UI Manager initialization failed - using console output\n");
+    if (!g_headless) {
+        // Initialize UI manager
+        if (!init_ui_manager()) {
+            printf("Warning: UI Manager initialization failed - using console output\n");
+        }
+        
+        // Initialize audio system
+        if (!init_audio_bridge()) {
+            printf("Warning: Audio system initialization failed - running without sound\n");
+        }
     }
     
-    // Initialize audio system
-    if (!init_audio_bridge()) {
-        printf("Warning: Audio system initialization failed - running without sound\n");
-    }
+    init_rollback(g_rollback_window);
     
-    // Seed random number generator
-    srand((unsigned int)time(NULL));
+    // Recording, replay and rollback need the same enemies to think on the same ticks
+    set_deterministic_ai(replay_is_playing() || g_record_file != NULL || rollback_window() > 0);
+    if (g_record_file) {
+        GameState* game_state = get_game_state();
+        ReplayHeader header;
+        memset(&header, 0, sizeof(ReplayHeader));
+        header.magic = REPLAY_MAGIC;
+        header.version = REPLAY_VERSION;
+        header.tick_rate = SIMULATION_TICK_RATE;
+        header.seed = rng_get_seed();
+        header.flags = g_headless ? REPLAY_FLAG_HEADLESS : 0;
+        header.max_enemies = game_state->max_enemies;
+        header.max_projectiles = game_state->max_projectiles;
+        replay_record_start(g_record_file, &header);
+    }
     
-    printf("Core Engine initialized - Target FPS: %d\n", g_game_loop.target_fps);
+    printf("Core Engine initialized - Target FPS: %d, Simulation: %d Hz\n",
+           g_game_loop.target_fps, SIMULATION_TICK_RATE);
+    return 1;
 }
 
 void run_game_loop() {
@@ -108,43 +160,94 @@ void run_game_loop() {
     // Start menu music
     start_menu_music();
     
-    double target_frame_time = 1.0 / g_game_loop.target_fps;
+    // From here on the simulation thread owns the live state and audio,
+    // this thread only draws snapshots
+    int threaded = use_sim_thread() && start_sim_thread();
+    GameState* view = game_state;
+    
+    // Frames are paced against absolute deadlines so sleep error does not accumulate
+    double next_frame_time = get_current_time();
     int frame_count = 0;
+    unsigned long frame_index = 0;
     double fps_timer = 0.0;
     double status_timer = 0.0;
     
-    while (game_state->game_running) {
+    while (view->game_running) {
+        TRACE_BEGIN("frame");
+        arena_reset(get_frame_arena());
+        
         // Calculate delta time
         g_game_loop.current_time = get_current_time();
         g_game_loop.delta_time = g_game_loop.current_time - g_game_loop.last_time;
         g_game_loop.last_time = g_game_loop.current_time;
         
-        // Cap delta time to prevent large jumps
-        if (g_game_loop.delta_time > 0.05) {
-            g_game_loop.delta_time = 0.05;
+        // The first delta covers startup, not a frame
+        if (frame_index++ > 0) {
+            frame_stats_record(FRAME_STAT_FRAME, g_game_loop.delta_time);
         }
         
-        // Update game logic
-        update_game_logic((float)g_game_loop.delta_time);
-        
-        // Update physics
-        update_physics((float)g_game_loop.delta_time);
+        if (threaded) {
+            // Draw the newest published tick, blended from the tick before it
+            // by the time since it was due
+            GameSnapshot* snapshot = sim_thread_acquire_snapshot();
+            double alpha = (g_game_loop.current_time - snapshot->tick_time) / SIMULATION_TICK_TIME;
+            snapshot->state.interpolation_alpha = (float)(alpha < 0.0 ? 0.0 : (alpha > 1.0 ? 1.0 : alpha));
+            view = &snapshot->state;
+            set_presented_game_state(view);
+        } else {
+            // Run as many fixed ticks as the elapsed time covers, after
+            // re-running any ticks whose inputs were corrected
+            g_game_loop.accumulator += g_game_loop.delta_time;
+            int ticks = 0;
+            double simulation_start = get_current_time();
+            rollback_resimulate();
+            while (g_game_loop.accumulator >= SIMULATION_TICK_TIME && ticks < MAX_TICKS_PER_FRAME &&
+                   game_state->game_running) {
+                run_simulation_tick();
+                g_game_loop.accumulator -= SIMULATION_TICK_TIME;
+                ticks++;
+            }
+            if (ticks > 0) {
+                frame_stats_record(FRAME_STAT_SIMULATION, get_current_time() - simulation_start);
+            }
+            
+            // Too far behind (breakpoint, window drag): drop whole ticks rather
+            // than spiral, the simulation just runs slower than real time
+            if (g_game_loop.accumulator >= SIMULATION_TICK_TIME) {
+                g_game_loop.accumulator = fmod(g_game_loop.accumulator, SIMULATION_TICK_TIME);
+            }
+            
+            // Rendering blends the last two ticks by the leftover time
+            game_state->interpolation_alpha = (float)(g_game_loop.accumulator / SIMULATION_TICK_TIME);
+        }
         
         // Update UI
+        TRACE_BEGIN("update_ui_manager");
         update_ui_manager((float)g_game_loop.delta_time);
+        TRACE_END();
         
-        // Update audio system
-        update_audio_system(game_state, (float)g_game_loop.delta_time);
+        // Update audio system (the simulation thread does this when it runs)
+        if (!threaded) {
+            TRACE_BEGIN("update_audio_system");
+            update_audio_system(game_state, (float)g_game_loop.delta_time);
+            TRACE_END();
+        }
         
         // Render frame
-        render_game_frame(game_state);
+        double render_start = get_current_time();
+        TRACE_BEGIN("render_game_frame");
+        render_game_frame(view, (float)g_game_loop.delta_time);
+        TRACE_END();
         
         // Render UI overlay
+        TRACE_BEGIN("render_ui_manager");
         render_ui_manager();
+        TRACE_END();
+        frame_stats_record(FRAME_STAT_RENDER, get_current_time() - render_start);
         
         // Check if graphics window should close
         if (graphics_should_close()) {
-            game_state->game_running = 0;
+            view->game_running = 0;
             printf("Graphics window closed\n");
         }
         
@@ -154,17 +257,19 @@ void run_game_loop() {
         status_timer += g_game_loop.delta_time;
         
         if (fps_timer >= 1.0) {
-            printf("FPS: %d, Delta: %.3fms, Phase: %s\n", 
-                   frame_count, g_game_loop.delta_time * 1000.0,
-                   game_state->current_phase == GAME_PLAYING ? "PLAYING" :
-                   game_state->current_phase == GAME_PAUSED ? "PAUSED" : "OTHER");
+            FrameStatsSummary frame_stats;
+            frame_stats_get_summary(FRAME_STAT_FRAME, FRAME_STATS_RECENT, &frame_stats);
+            printf("FPS: %d, Delta: %.3fms, p99: %.2fms, Max: %.2fms, Phase: %s\n", 
+                   frame_count, g_game_loop.delta_time * 1000.0, frame_stats.p99_ms, frame_stats.max_ms,
+                   view->current_phase == GAME_PLAYING ? "PLAYING" :
+                   view->current_phase == GAME_PAUSED ? "PAUSED" : "OTHER");
             frame_count = 0;
             fps_timer = 0.0;
         }
         
         // Game status every 3 seconds
         if (status_timer >= 3.0) {
-            PlayerState* player = &game_state->player;
+            const PlayerState* player = &view->player;
             printf("=== GAME STATUS ===\n");
             printf("Player: Pos(%.2f,%.2f,%.2f) Health:%d/%d\n",
                    player->position.x, player->position.y, player->position.z,
@@ -178,26 +283,210 @@ void run_game_loop() {
             
             printf("Ground:%s Jumps:%d Enemies:%d Projectiles:%d Score:%d\n",
                    player->on_ground ? "YES" : "NO", player->consecutive_jumps,
-                   game_state->enemy_count, game_state->projectile_count, game_state->score);
+                   view->enemy_count, view->projectile_count, view->score);
+            
+            FrameStatsSummary frame_stats;
+            frame_stats_get_summary(FRAME_STAT_FRAME, FRAME_STATS_RECENT, &frame_stats);
+            printf("Frame: p50 %.2fms p95 %.2fms p99 %.2fms p99.9 %.2fms max %.2fms",
+                   frame_stats.p50_ms, frame_stats.p95_ms, frame_stats.p99_ms,
+                   frame_stats.p999_ms, frame_stats.max_ms);
+            for (int i = 0; i < frame_stats.hitch_threshold_count; i++) {
+                printf(" >%.0fms:%u", frame_stats.hitch_threshold_ms[i], frame_stats.hitches[i]);
+            }
+            printf("\n");
             printf("==================\n");
             status_timer = 0.0;
         }
         
+        TRACE_END(); // frame
+        
+        // Trace captures start and stop between frames, outside any tick
+        if (trace_take_request()) {
+            sim_thread_lock();
+            trace_toggle(DEFAULT_TRACE_FILE);
+            sim_thread_unlock();
+        }
+        
         // Frame rate limiting
-        double frame_end_time = get_current_time();
-        double frame_duration = frame_end_time - g_game_loop.current_time;
+        double target_frame_time = 1.0 / g_game_loop.target_fps;
+        next_frame_time += target_frame_time;
         
-        if (frame_duration < target_frame_time) {
-            int sleep_time = (int)((target_frame_time - frame_duration) * 1000.0);
-            if (sleep_time > 0) {
-                sleep_ms(sleep_time);
-            }
+        double now = get_current_time();
+        if (now - next_frame_time > target_frame_time) {
+            // More than a frame late: start over from now instead of rushing
+            // through frames to catch up
+            next_frame_time = now;
+        } else {
+            TRACE_BEGIN("frame_wait");
+            wait_until(next_frame_time);
+            TRACE_END();
         }
     }
     
+    if (threaded) {
+        stop_sim_thread();
+        set_presented_game_state(NULL);
+        game_state->game_running = 0;
+    }
+    
     printf("Game loop ended\n");
 }
 
+static void end_replay() {
+    GameState* game_state = get_game_state();
+    unsigned int checksum = compute_game_state_checksum(game_state);
+    
+    if (checksum == replay_expected_checksum()) {
+        printf("Replay finished after %lu ticks - state matches the recording (%08x)\n",
+               g_game_loop.tick_count, checksum);
+    } else {
+        printf("Replay finished after %lu ticks - state DIVERGED from the recording (%08x, expected %08x)\n",
+               g_game_loop.tick_count, checksum, replay_expected_checksum());
+    }
+    game_state->game_running = 0;
+}
+
+void run_simulation_tick() {
+    TRACE_BEGIN("simulation_tick");
+    arena_reset(get_tick_arena());
+    rollback_begin_tick(g_game_loop.tick_count);
+    
+    // Phase changes and quit requests made by the UI since the last tick,
+    // a re-simulated tick takes them from the rollback history instead
+    if (!rollback_is_resimulating()) {
+        apply_game_requests();
+    }
+    
+    // Entities created during the tick start with previous == current
+    save_previous_positions();
+    
+    TRACE_BEGIN("update_game_logic");
+    update_game_logic((float)SIMULATION_TICK_TIME);
+    TRACE_END();
+    
+    TRACE_BEGIN("update_physics");
+    double physics_start = get_current_time();
+    update_physics((float)SIMULATION_TICK_TIME);
+    if (!rollback_is_resimulating()) {
+        g_sim_timings.physics += get_current_time() - physics_start;
+    }
+    TRACE_END();
+    
+    // Re-simulated ticks are counted in RollbackStats, not here
+    if (!rollback_is_resimulating()) {
+        g_sim_timings.ticks++;
+    }
+    g_game_loop.tick_count++;
+    
+    // A replay stops on the tick its recording did
+    if (replay_is_playing() && g_game_loop.tick_count == replay_end_tick() && !rollback_is_resimulating()) {
+        end_replay();
+    }
+    
+    TRACE_END();
+}
+
+void run_headless_loop(int tick_count) {
+    printf("Running %d headless ticks at %d Hz...\n", tick_count, SIMULATION_TICK_RATE);
+    
+    GameState* game_state = get_game_state();
+    
+    // Replaying a windowed session as fast as possible runs it from the
+    // state it started in, without the benchmark script
+    int scripted = !replay_is_playing() || (replay_get_header()->flags & REPLAY_FLAG_HEADLESS);
+    if (scripted) {
+        game_state->current_phase = GAME_PLAYING;
+        set_scripted_input(1);
+        
+        // Start from a populated level instead of waiting for the spawn timer,
+        // a loaded snapshot already brings its own
+        if (game_state->enemy_count == 0) {
+            spawn_enemy_wave(game_state->max_enemies / 2);
+        }
+    }
+    
+    reset_simulation_timings();
+    frame_stats_reset();
+    double start_time = get_current_time();
+    
+    // With rollback on, rewind a full window every few ticks and check the
+    // re-simulated present matches. The health reset below happens outside
+    // any tick, so windows containing one are skipped.
+    unsigned long window = (unsigned long)rollback_window();
+    unsigned long last_reset_tick = 0;
+    int rollback_checks = 0;
+    int rollback_mismatches = 0;
+    double rollback_time = 0.0;
+    long long allocations_start = -1;
+    
+    for (int i = 0; i < tick_count && game_state->game_running; i++) {
+        if (i == HEADLESS_WARMUP_TICKS) {
+            allocations_start = alloc_counter_get();
+        }
+        
+        // Measure steady-state gameplay, never the game over screen
+        if (scripted && (game_state->player.health <= 0 || game_state->current_phase != GAME_PLAYING)) {
+            game_state->player.health = game_state->player.max_health;
+            game_state->current_phase = GAME_PLAYING;
+            last_reset_tick = get_simulation_tick();
+        }
+        
+        double tick_start = get_current_time();
+        run_simulation_tick();
+        frame_stats_record(FRAME_STAT_SIMULATION, get_current_time() - tick_start);
+        
+        unsigned long tick = get_simulation_tick();
+        if (window > 0 && tick % HEADLESS_ROLLBACK_INTERVAL == 0 && tick >= last_reset_tick + window) {
+            double rollback_start = get_current_time();
+            unsigned int expected = compute_game_state_checksum(game_state);
+            rollback_invalidate(tick - window);
+            rollback_resimulate();
+            rollback_checks++;
+            if (compute_game_state_checksum(game_state) != expected) {
+                rollback_mismatches++;
+            }
+            rollback_time += get_current_time() - rollback_start;
+        }
+    }
+    
+    // Rewinds are reported separately below, ticks/s covers forward ticks only
+    double elapsed = get_current_time() - start_time - rollback_time;
+    g_sim_timings.allocations = (alloc_counter_available() && allocations_start >= 0) ?
+                                alloc_counter_get() - allocations_start : -1;
+    log_flush();
+    
+    const SimulationTimings* timings = &g_sim_timings;
+    double ticks = timings->ticks > 0 ? (double)timings->ticks : 1.0;
+    
+    printf("=== HEADLESS BENCHMARK ===\n");
+    printf("Ticks: %lu in %.3f s (%.0f ticks/s, %.1fx real time)\n",
+           timings->ticks, elapsed, elapsed > 0.0 ? timings->ticks / elapsed : 0.0,
+           elapsed > 0.0 ? timings->ticks * SIMULATION_TICK_TIME / elapsed : 0.0);
+    printf("Per tick: input %.3f ms, enemies %.3f ms, projectiles %.3f ms, spawning %.3f ms, physics %.3f ms\n",
+           timings->input * 1000.0 / ticks, timings->enemies * 1000.0 / ticks,
+           timings->projectiles * 1000.0 / ticks, timings->spawning * 1000.0 / ticks,
+           timings->physics * 1000.0 / ticks);
+    
+    FrameStatsSummary tick_stats;
+    frame_stats_get_summary(FRAME_STAT_SIMULATION, FRAME_STATS_SESSION, &tick_stats);
+    printf("Tick time: p50 %.3f ms, p99 %.3f ms, p99.9 %.3f ms, max %.3f ms\n",
+           tick_stats.p50_ms, tick_stats.p99_ms, tick_stats.p999_ms, tick_stats.max_ms);
+    printf("Enemies: %d Projectiles: %d Score: %d\n",
+           game_state->enemy_count, game_state->projectile_count, game_state->score);
+    if (timings->allocations >= 0) {
+        printf("Heap allocations after warm-up: %lld\n", timings->allocations);
+    }
+    if (rollback_checks > 0) {
+        const RollbackStats* rollback = get_rollback_stats();
+        printf("Rollback: %d rewinds of %lu ticks, %.3f ms each, %d diverged\n",
+               rollback_checks, window, rollback->resimulation_time * 1000.0 / rollback->rollbacks,
+               rollback_mismatches);
+    }
+    printf("==========================\n");
+    
+    set_scripted_input(0);
+}
+
 void update_game_logic(float delta_time) {
     GameState* game_state = get_game_state();
     
@@ -205,27 +494,33 @@ void update_game_logic(float delta_time) {
     update_game_state(delta_time);
     
     // Process input (placeholder - will be implemented in input manager)
+    double input_start = get_current_time();
     process_input();
+    if (!rollback_is_resimulating()) {
+        g_sim_timings.input += get_current_time() - input_start;
+    }
     
     // Update game phase logic
-    static GamePhase last_phase = GAME_MENU;
-    if (game_state->current_phase != last_phase) {
-        // Phase changed, update music
-        switch (game_state->current_phase) {
-            case GAME_MENU:
-                start_menu_music();
-                break;
-            case GAME_PLAYING:
-                start_background_music();
-                break;
-            case GAME_PAUSED:
-                // Keep current music but could lower volume
-                break;
-            case GAME_OVER:
-                stop_current_music();
-                break;
+    if (game_state->current_phase != g_music_phase) {
+        // Phase changed, update music. A re-simulated tick only catches the
+        // phase up, the music switched when the tick ran live.
+        if (!rollback_is_resimulating()) {
+            switch (game_state->current_phase) {
+                case GAME_MENU:
+                    start_menu_music();
+                    break;
+                case GAME_PLAYING:
+                    start_background_music();
+                    break;
+                case GAME_PAUSED:
+                    // Keep current music but could lower volume
+                    break;
+                case GAME_OVER:
+                    stop_current_music();
+                    break;
+            }
         }
-        last_phase = game_state->current_phase;
+        g_music_phase = game_state->current_phase;
     }
     
     switch (game_state->current_phase) {
@@ -244,11 +539,10 @@ void update_game_logic(float delta_time) {
             
         case GAME_OVER:
             // Game over logic - stop the game after showing final score
-            static float game_over_timer = 0.0f;
-            game_over_timer += delta_time;
-            if (game_over_timer > 3.0f) { // Show game over for 3 seconds
+            g_game_over_timer += delta_time;
+            if (g_game_over_timer > 3.0f) { // Show game over for 3 seconds
                 game_state->current_phase = GAME_MENU;
-                game_over_timer = 0.0f;
+                g_game_over_timer = 0.0f;
             }
             break;
     }
@@ -258,21 +552,29 @@ void update_gameplay(float delta_time) {
     GameState* game_state = get_game_state();
     
     // Update game objects
+    double enemies_start = get_current_time();
     update_enemies(delta_time);
+    double projectiles_start = get_current_time();
     update_projectiles(delta_time);
+    double spawning_start = get_current_time();
     
     // Spawn enemies periodically
     spawn_enemies_periodically(delta_time);
+    if (!rollback_is_resimulating()) {
+        g_sim_timings.enemies += projectiles_start - enemies_start;
+        g_sim_timings.projectiles += spawning_start - projectiles_start;
+        g_sim_timings.spawning += get_current_time() - spawning_start;
+    }
     
     // Check game over condition
     if (game_state->player.health <= 0) {
         game_state->current_phase = GAME_OVER;
-        printf("GAME OVER! Final Score: %d\n", game_state->score);
+        LOG_INFO(LOG_CATEGORY_GAMEPLAY, "GAME OVER! Final Score: %d", game_state->score);
     }
 }
 
 void set_target_fps(int fps) {
-    if (fps > 0 && fps <= 300) {
+    if (fps > 0 && fps <= MAX_TARGET_FPS) {
         g_game_loop.target_fps = fps;
         printf("Target FPS set to: %d\n", fps);
     }
@@ -282,18 +584,87 @@ int get_target_fps() {
     return g_game_loop.target_fps;
 }
 
+void set_job_worker_count(int workers) {
+    g_job_workers = workers;
+}
+
+void set_sim_thread_mode(int mode) {
+    g_sim_thread_mode = mode;
+}
+
+void set_record_file(const char* path) {
+    g_record_file = path;
+}
+
+void set_random_seed(unsigned int seed) {
+    g_random_seed = seed;
+    g_random_seed_set = 1;
+}
+
+void set_rollback_window(int ticks) {
+    g_rollback_window = ticks;
+}
+
+void set_headless_mode(int enabled) {
+    g_headless = enabled;
+}
+
+int is_headless_mode() {
+    return g_headless;
+}
+
+const SimulationTimings* get_simulation_timings() {
+    return &g_sim_timings;
+}
+
+void reset_simulation_timings() {
+    memset(&g_sim_timings, 0, sizeof(SimulationTimings));
+    g_sim_timings.allocations = -1;
+}
+
 double get_delta_time() {
     return g_game_loop.delta_time;
 }
 
+unsigned long get_simulation_tick() {
+    return g_game_loop.tick_count;
+}
+
+void save_loop_snapshot(LoopSnapshot* snapshot) {
+    snapshot->tick_count = g_game_loop.tick_count;
+    snapshot->game_over_timer = g_game_over_timer;
+    snapshot->music_phase = g_music_phase;
+}
+
+void load_loop_snapshot(const LoopSnapshot* snapshot) {
+    g_game_loop.tick_count = snapshot->tick_count;
+    g_game_over_timer = snapshot->game_over_timer;
+    g_music_phase = snapshot->music_phase;
+}
+
 void cleanup_core() {
     printf("Cleaning up Core Engine...\n");
-    cleanup_audio_bridge();
-    cleanup_ui_manager();
+    if (replay_is_recording()) {
+        replay_record_stop(g_game_loop.tick_count, compute_game_state_checksum(get_game_state()));
+    }
+    replay_close();
+    cleanup_rollback();
+    if (!g_headless) {
+        cleanup_audio_bridge();
+        cleanup_ui_manager();
+    }
     cleanup_physics_engine();
-    cleanup_graphics_engine();
+    if (!g_headless) {
+        cleanup_graphics_engine();
+    }
     cleanup_object_manager();
     cleanup_input_manager();
     cleanup_game_state();
+    cleanup_job_system();
+    cleanup_frame_stats();
+    cleanup_transient_arenas();
+    cleanup_trace();
+    cleanup_log();
+    cleanup_timer();
     printf("Core Engine cleaned up\n");
 }
\ No newline at end of file
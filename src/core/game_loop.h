@@ -1,24 +1,91 @@
 #ifndef GAME_LOOP_H
 #define GAME_LOOP_H
 
+#include "game_api.h"
+
+// Gameplay and physics advance in fixed ticks, independent of the render rate
+#define SIMULATION_TICK_RATE 128
+#define SIMULATION_TICK_TIME (1.0 / SIMULATION_TICK_RATE)
+
+// Ticks run per rendered frame before the loop gives up catching up
+#define MAX_TICKS_PER_FRAME 8
+
+// Highest frame rate the limiter accepts (benchmarking)
+#define MAX_TARGET_FPS 1000
+
 // Game loop structure
 typedef struct {
     double last_time;
     double current_time;
-    double delta_time;
+    double delta_time;          // Real time of the last frame
+    double accumulator;         // Unsimulated time, always below one tick after a frame
+    unsigned long tick_count;   // Simulation ticks run since startup
     int target_fps;
 } GameLoop;
 
+// Loop state that belongs to the simulation, saved with game snapshots
+typedef struct {
+    unsigned long tick_count;
+    float game_over_timer;
+    GamePhase music_phase;      // Phase the music was last switched for
+} LoopSnapshot;
+
+// Wall time spent per subsystem over the simulation ticks run so far
+typedef struct {
+    double input;
+    double enemies;
+    double projectiles;
+    double spawning;
+    double physics;
+    unsigned long ticks;
+    long long allocations;      // Heap allocations by headless ticks after warm-up, -1 when not counted
+} SimulationTimings;
+
 // Core Engine function declarations
-void init_core_engine();
+int init_core_engine();
 void run_game_loop();
 void update_game_logic(float delta_time);
 void update_gameplay(float delta_time);
+
+// Run one fixed simulation tick of gameplay and physics
+void run_simulation_tick();
+
+// Simulation thread for run_game_loop(): 1 on, 0 off, -1 (default) on when
+// the job system has more than one thread
+void set_sim_thread_mode(int mode);
+
+// Record every input event to path (see replay.h); set before init_core_engine()
+void set_record_file(const char* path);
+
+// Seed for the random streams (rng.h), otherwise the current time. A loaded replay overrides it.
+void set_random_seed(unsigned int seed);
+
+// Ticks of rollback history (rollback.h), 0 (default) disables; set before init_core_engine()
+void set_rollback_window(int ticks);
+
+// Headless mode skips graphics, UI and audio; set before init_core_engine()
+void set_headless_mode(int enabled);
+int is_headless_mode();
+
+// Run tick_count simulation ticks back to back with scripted input and print
+// ticks per second and per-subsystem time
+void run_headless_loop(int tick_count);
+
+const SimulationTimings* get_simulation_timings();
+void reset_simulation_timings();
 void cleanup_core();
 
+// Worker threads for the job system, applied by init_core_engine()
+// (-1 = one per extra CPU core, 0 = single threaded)
+void set_job_worker_count(int workers);
+
 // FPS control functions
 void set_target_fps(int fps);
 int get_target_fps();
 double get_delta_time();
+unsigned long get_simulation_tick();
+
+void save_loop_snapshot(LoopSnapshot* snapshot);
+void load_loop_snapshot(const LoopSnapshot* snapshot);
 
 #endif // GAME_LOOP_H
\ No newline at end of file
@@ -1,10 +1,91 @@
 #include "game_state.h"
 #include "game_api.h"
+#include "entity_pool.h"
+#include "arena.h"
+#include "log.h"
+#include "atomics.h"
+#include "replay.h"
+#include "rollback.h"
+#include "game_loop.h"
+#include "object_manager.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <math.h>
 
 static GameState g_game_state;
+static GameState* g_presented_state = NULL;
+
+// Requests from the UI thread, -1 / 0 when there is none
+static volatile int32_t g_requested_phase = -1;
+static volatile int32_t g_quit_requested = 0;
+
+// Entity capacities applied by the next init_game_state()
+static int g_max_enemies = DEFAULT_MAX_ENEMIES;
+static int g_max_projectiles = DEFAULT_MAX_PROJECTILES;
+
+// Level arena backing the entity arrays and pool bookkeeping
+static Arena g_level_arena;
+
+static size_t level_arena_size(int max_enemies, int max_projectiles) {
+    // Each allocation may be padded up to the default alignment. The object
+    // manager carves its per-level storage from the same arena.
+    return (size_t)max_enemies * sizeof(Enemy) +
+           (size_t)max_projectiles * sizeof(Projectile) +
+           entity_pool_storage_size(max_enemies) +
+           entity_pool_storage_size(max_projectiles) +
+           4 * ARENA_DEFAULT_ALIGNMENT +
+           object_manager_storage_size(max_enemies, max_projectiles);
+}
+
+static int clamp_capacity(int capacity) {
+    if (capacity < 1) return 1;
+    if (capacity > MAX_ENTITY_CAPACITY) return MAX_ENTITY_CAPACITY;
+    return capacity;
+}
+
+void set_entity_capacities(int max_enemies, int max_projectiles) {
+    g_max_enemies = clamp_capacity(max_enemies);
+    g_max_projectiles = clamp_capacity(max_projectiles);
+    
+    printf("Entity capacities set - enemies: %d, projectiles: %d\n",
+           g_max_enemies, g_max_projectiles);
+}
+
+Arena* get_level_arena() {
+    return &g_level_arena;
+}
+
+static void init_entity_storage() {
+    size_t needed = level_arena_size(g_max_enemies, g_max_projectiles);
+    if (g_level_arena.head && g_level_arena.reserved >= needed) {
+        arena_reset(&g_level_arena);
+    } else {
+        arena_destroy(&g_level_arena);
+        arena_init(&g_level_arena, needed);
+    }
+    
+    Arena* arena = &g_level_arena;
+    g_game_state.enemies = (Enemy*)arena_alloc_zeroed(arena, (size_t)g_max_enemies * sizeof(Enemy), 0);
+    g_game_state.projectiles = (Projectile*)arena_alloc_zeroed(arena, (size_t)g_max_projectiles * sizeof(Projectile), 0);
+    void* enemy_pool_storage = arena_alloc(arena, entity_pool_storage_size(g_max_enemies), 0);
+    void* projectile_pool_storage = arena_alloc(arena, entity_pool_storage_size(g_max_projectiles), 0);
+    
+    if (!g_game_state.enemies || !enemy_pool_storage) {
+        printf("Failed to allocate storage for %d enemies\n", g_max_enemies);
+        enemy_pool_storage = NULL;
+    }
+    if (!g_game_state.projectiles || !projectile_pool_storage) {
+        printf("Failed to allocate storage for %d projectiles\n", g_max_projectiles);
+        projectile_pool_storage = NULL;
+    }
+    
+    // A pool without storage ends up with capacity 0, so nothing can spawn
+    entity_pool_init(&g_game_state.enemy_pool, g_max_enemies, enemy_pool_storage);
+    entity_pool_init(&g_game_state.projectile_pool, g_max_projectiles, projectile_pool_storage);
+    g_game_state.max_enemies = g_game_state.enemy_pool.capacity;
+    g_game_state.max_projectiles = g_game_state.projectile_pool.capacity;
+}
 
 void init_game_state() {
     memset(&g_game_state, 0, sizeof(GameState));
@@ -33,8 +114,13 @@ void init_game_state() {
     g_game_state.game_running = 1;
     g_game_state.current_phase = GAME_MENU;
     
+    // Initialize entity storage and pools
+    init_entity_storage();
+    
     printf("Game State initialized - Player health: %d, ammo: %d\n", 
            g_game_state.player.health, g_game_state.player.ammo);
+    printf("Entity capacity - enemies: %d, projectiles: %d (%zu bytes)\n",
+           g_game_state.max_enemies, g_game_state.max_projectiles, g_level_arena.used);
 }
 
 GameState* get_game_state() {
@@ -56,26 +142,110 @@ void update_game_state(float delta_time) {
                                      g_game_state.player.velocity.z * g_game_state.player.velocity.z);
 }
 
+void save_previous_positions() {
+    g_game_state.player.previous_position = g_game_state.player.position;
+    
+    EntityPool* enemy_pool = &g_game_state.enemy_pool;
+    for (int i = 0; i < enemy_pool->count; i++) {
+        Enemy* enemy = &g_game_state.enemies[enemy_pool->alive[i]];
+        enemy->previous_position = enemy->position;
+    }
+    
+    EntityPool* projectile_pool = &g_game_state.projectile_pool;
+    for (int i = 0; i < projectile_pool->count; i++) {
+        Projectile* projectile = &g_game_state.projectiles[projectile_pool->alive[i]];
+        projectile->previous_position = projectile->position;
+    }
+}
+
 GameState* get_core_game_state() {
-    return &g_game_state;
+    return g_presented_state ? g_presented_state : &g_game_state;
+}
+
+void set_presented_game_state(GameState* state) {
+    g_presented_state = state;
 }
 
 void set_game_phase(int phase) {
     if (phase >= 0 && phase <= 3) {
-        g_game_state.current_phase = (GamePhase)phase;
-        printf("Game phase changed to: %d\n", phase);
+        atomic_store_i32(&g_requested_phase, phase);
     }
 }
 
 int get_game_phase() {
-    return (int)g_game_state.current_phase;
+    return (int)get_core_game_state()->current_phase;
 }
 
 void quit_game() {
-    g_game_state.game_running = 0;
+    atomic_store_i32(&g_quit_requested, 1);
     printf("Game quit requested\n");
 }
 
+void apply_game_requests() {
+    int32_t phase = atomic_exchange_i32(&g_requested_phase, -1);
+    
+    // A replay takes its phase changes from the recording
+    if (phase >= 0 && !replay_is_playing()) {
+        g_game_state.current_phase = (GamePhase)phase;
+        LOG_INFO(LOG_CATEGORY_GAMEPLAY, "Game phase changed to: %d", phase);
+        
+        ReplayEvent event = { REPLAY_EVENT_PHASE, phase, 0, 0.0f, 0.0f };
+        replay_record_event(get_simulation_tick(), &event);
+        rollback_record_input(get_simulation_tick(), &event);
+    }
+    
+    if (atomic_exchange_i32(&g_quit_requested, 0)) {
+        g_game_state.game_running = 0;
+        
+        ReplayEvent event = { REPLAY_EVENT_QUIT, 0, 0, 0.0f, 0.0f };
+        replay_record_event(get_simulation_tick(), &event);
+        rollback_record_input(get_simulation_tick(), &event);
+    }
+}
+
+static unsigned int checksum_bytes(unsigned int hash, const void* data, size_t size) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+unsigned int compute_game_state_checksum(const GameState* state) {
+    // FNV-1a over the player, the counters and every live entity in pool order
+    unsigned int hash = 2166136261u;
+    hash = checksum_bytes(hash, &state->player, sizeof(PlayerState));
+    hash = checksum_bytes(hash, &state->score, sizeof(int));
+    hash = checksum_bytes(hash, &state->current_phase, sizeof(GamePhase));
+    
+    for (int i = 0; i < state->enemy_pool.count; i++) {
+        int slot = state->enemy_pool.alive[i];
+        const Enemy* enemy = &state->enemies[slot];
+        hash = checksum_bytes(hash, &slot, sizeof(int));
+        hash = checksum_bytes(hash, &enemy->position, sizeof(Vector3));
+        hash = checksum_bytes(hash, &enemy->velocity, sizeof(Vector3));
+        hash = checksum_bytes(hash, &enemy->health, sizeof(float));
+        hash = checksum_bytes(hash, &enemy->ai_state, sizeof(AIState));
+    }
+    
+    for (int i = 0; i < state->projectile_pool.count; i++) {
+        int slot = state->projectile_pool.alive[i];
+        const Projectile* projectile = &state->projectiles[slot];
+        hash = checksum_bytes(hash, &slot, sizeof(int));
+        hash = checksum_bytes(hash, &projectile->position, sizeof(Vector3));
+        hash = checksum_bytes(hash, &projectile->velocity, sizeof(Vector3));
+    }
+    return hash;
+}
+
 void cleanup_game_state() {
+    arena_destroy(&g_level_arena);
+    g_game_state.enemies = NULL;
+    g_game_state.projectiles = NULL;
+    g_game_state.max_enemies = 0;
+    g_game_state.max_projectiles = 0;
+    memset(&g_game_state.enemy_pool, 0, sizeof(EntityPool));
+    memset(&g_game_state.projectile_pool, 0, sizeof(EntityPool));
+    
     printf("Game State cleaned up\n");
 }
\ No newline at end of file
@@ -2,16 +2,44 @@
 #define GAME_STATE_H
 
 #include "game_api.h"
+#include "arena.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Entity capacities used by the next init_game_state(), clamped to MAX_ENTITY_CAPACITY
+void set_entity_capacities(int max_enemies, int max_projectiles);
 
 void init_game_state();
 GameState* get_game_state();
-GameState* get_core_game_state(); // For UI bridge
+GameState* get_core_game_state(); // For UI bridge, the state being presented
+
+// State the UI reads while the simulation runs on its own thread (the
+// snapshot being rendered). NULL presents the live state again.
+void set_presented_game_state(GameState* state);
 void update_game_state(float delta_time);
+
+// Copy every entity's position to previous_position before a simulation tick
+void save_previous_positions();
 void cleanup_game_state();
 
-// Game phase control functions
+// Arena holding per-level storage, reset by init_game_state()
+Arena* get_level_arena();
+
+// Game phase control functions. Changes are requests from the UI, applied
+// by apply_game_requests() at the start of the next simulation tick.
 void set_game_phase(int phase);
 int get_game_phase();
 void quit_game();
+void apply_game_requests();
+
+// Hash of the simulated state (player, score, live entities), equal for two
+// runs that stayed in lockstep. Used to check replays.
+unsigned int compute_game_state_checksum(const GameState* state);
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif // GAME_STATE_H
\ No newline at end of file
@@ -1,6 +1,12 @@
 #include "input_manager.h"
 #include "game_state.h"
 #include "object_manager.h"
+#include "log.h"
+#include "trace.h"
+#include "atomics.h"
+#include "replay.h"
+#include "rollback.h"
+#include "game_loop.h"
 #include "../physics_bridge.h"
 #include "../audio_bridge.h"
 #include <stdio.h>
@@ -21,7 +27,16 @@
 #endif
 
 static InputState g_input_state;
+static InputTimers g_input_timers;
 static int g_input_initialized = 0;
+static int g_scripted_input = 0;
+
+// Events from the window and UI wait here until the next tick applies them,
+// so every event lands on a known tick (and on the simulation thread)
+#define INPUT_QUEUE_SIZE 256
+static ReplayEvent g_input_queue[INPUT_QUEUE_SIZE];
+static int g_input_queue_count = 0;
+static volatile int32_t g_input_queue_lock = 0;
 
 // Key codes for cross-platform compatibility
 #define KEY_W 'w'
@@ -85,6 +100,7 @@ static int getch_nb() {
 
 void init_input_manager() {
     memset(&g_input_state, 0, sizeof(InputState));
+    memset(&g_input_timers, 0, sizeof(InputTimers));
     g_input_state.mouse_sensitivity = 2.0f;
     g_input_state.mouse_x = 0.0f;
     g_input_state.mouse_y = 0.0f;
@@ -98,51 +114,38 @@ void init_input_manager() {
     printf("Controls: WASD - Move, SPACE - Jump, Q - Quit, ESC - Pause\n");
 }
 
-void process_input() {
-    if (!g_input_initialized) return;
-    
-    GameState* game_state = get_game_state();
-    if (!game_state) return;
+// Deterministic input for headless runs: run forward, strafe left and right,
+// chain jumps and keep firing
+static void apply_scripted_input(float delta_time) {
+    InputTimers* timers = &g_input_timers;
+    timers->script_time += delta_time;
+    timers->jump_timer += delta_time;
+    timers->fire_timer += delta_time;
     
-    // Reset frame-specific input
-    g_input_state.jump_pressed = 0;
-    g_input_state.mouse_delta_x = 0.0f;
-    g_input_state.mouse_delta_y = 0.0f;
+    int strafe_left = ((int)(timers->script_time / 2.0f) % 2) == 0;
+    g_input_state.keys[KEY_W] = 1;
+    g_input_state.keys[KEY_A] = strafe_left;
+    g_input_state.keys[KEY_D] = !strafe_left;
     
-    // Process keyboard input
-    while (kbhit()) {
-        int key = getch_nb();
-        if (key > 0) {
-            handle_keyboard_input(key, 1); // Key pressed
-        }
+    if (timers->jump_timer >= 0.6f) {
+        g_input_state.jump_pressed = 1;
+        timers->jump_timer = 0.0f;
     }
     
-    // Simulate mouse movement for testing (in real implementation, this would come from OS)
-    static float test_mouse_time = 0.0f;
-    test_mouse_time += game_state->delta_time;
-    
-    // Simulate slow mouse movement for camera rotation testing
-    float mouse_speed = 0.5f;
-    g_input_state.mouse_delta_x = sinf(test_mouse_time * mouse_speed) * 0.1f;
-    g_input_state.mouse_delta_y = cosf(test_mouse_time * mouse_speed * 0.7f) * 0.05f;
-    
-    // Simulate mouse clicks for shooting every 3 seconds
-    static float shoot_timer = 0.0f;
-    shoot_timer += game_state->delta_time;
-    if (shoot_timer >= 3.0f && game_state->current_phase == GAME_PLAYING) {
-        handle_mouse_click(0, 1); // Left mouse button click
-        shoot_timer = 0.0f;
+    if (timers->fire_timer >= 0.25f) {
+        fire_weapon();
+        timers->fire_timer = 0.0f;
     }
-    
-    // Update mouse position
-    g_input_state.mouse_x += g_input_state.mouse_delta_x;
-    g_input_state.mouse_y += g_input_state.mouse_delta_y;
-    
-    // Apply input to player movement
-    apply_input_to_player();
 }
 
-void handle_keyboard_input(int key, int action) {
+void set_scripted_input(int enabled) {
+    g_scripted_input = enabled;
+    if (!enabled) {
+        memset(g_input_state.keys, 0, sizeof(g_input_state.keys));
+    }
+}
+
+static void apply_keyboard_input(int key, int action) {
     // Convert to lowercase for consistency
     if (key >= 'A' && key <= 'Z') {
         key = key - 'A' + 'a';
@@ -158,7 +161,7 @@ void handle_keyboard_input(int key, int action) {
         case KEY_SPACE:
             if (action) {
                 g_input_state.jump_pressed = 1;
-                printf("Jump pressed!\n");
+                LOG_DEBUG(LOG_CATEGORY_INPUT, "Jump pressed!");
             }
             break;
             
@@ -167,10 +170,10 @@ void handle_keyboard_input(int key, int action) {
                 GameState* game_state = get_game_state();
                 if (game_state->current_phase == GAME_PLAYING) {
                     game_state->current_phase = GAME_PAUSED;
-                    printf("Game paused\n");
+                    LOG_INFO(LOG_CATEGORY_INPUT, "Game paused");
                 } else if (game_state->current_phase == GAME_PAUSED) {
                     game_state->current_phase = GAME_PLAYING;
-                    printf("Game resumed\n");
+                    LOG_INFO(LOG_CATEGORY_INPUT, "Game resumed");
                 }
             }
             break;
@@ -179,14 +182,20 @@ void handle_keyboard_input(int key, int action) {
             if (action) {
                 GameState* game_state = get_game_state();
                 game_state->game_running = 0;
-                printf("Quit requested\n");
+                LOG_INFO(LOG_CATEGORY_INPUT, "Quit requested");
             }
             break;
             
         case 'o': // Open audio settings
             if (action) {
-                printf("Audio settings toggled (press 1-6 to adjust volumes)\n");
-                printf("1/2: Master Volume +/-, 3/4: SFX Volume +/-, 5/6: Music Volume +/-\n");
+                LOG_INFO(LOG_CATEGORY_INPUT, "Audio settings toggled (press 1-6 to adjust volumes)");
+                LOG_INFO(LOG_CATEGORY_INPUT, "1/2: Master Volume +/-, 3/4: SFX Volume +/-, 5/6: Music Volume +/-");
+            }
+            break;
+            
+        case 't': // Start/stop a trace capture, once even if a rollback runs the tick again
+            if (action && !rollback_is_resimulating()) {
+                trace_request_toggle();
             }
             break;
             
@@ -199,7 +208,7 @@ void handle_keyboard_input(int key, int action) {
     }
 }
 
-void handle_mouse_movement(float x_offset, float y_offset) {
+static void apply_mouse_movement(float x_offset, float y_offset) {
     g_input_state.mouse_delta_x = x_offset * g_input_state.mouse_sensitivity;
     g_input_state.mouse_delta_y = y_offset * g_input_state.mouse_sensitivity;
     
@@ -211,7 +220,7 @@ void handle_mouse_movement(float x_offset, float y_offset) {
     if (g_input_state.mouse_y < -89.0f) g_input_state.mouse_y = -89.0f;
 }
 
-void handle_mouse_click(int button, int action) {
+static void apply_mouse_click(int button, int action) {
     if (button >= 0 && button < 8) {
         g_input_state.mouse_buttons[button] = action;
         
@@ -221,6 +230,170 @@ void handle_mouse_click(int button, int action) {
     }
 }
 
+static void apply_input_event(const ReplayEvent* event) {
+    GameState* game_state = get_game_state();
+    
+    switch (event->type) {
+        case REPLAY_EVENT_KEY:
+            apply_keyboard_input(event->code, event->action);
+            break;
+            
+        case REPLAY_EVENT_MOUSE_MOVE:
+            apply_mouse_movement(event->x, event->y);
+            break;
+            
+        case REPLAY_EVENT_MOUSE_CLICK:
+            apply_mouse_click(event->code, event->action);
+            break;
+            
+        case REPLAY_EVENT_PHASE:
+            game_state->current_phase = (GamePhase)event->code;
+            LOG_INFO(LOG_CATEGORY_INPUT, "Game phase changed to: %d", event->code);
+            break;
+            
+        case REPLAY_EVENT_QUIT:
+            game_state->game_running = 0;
+            break;
+    }
+}
+
+// Live input is recorded on the tick it is applied
+static void record_input_event(const ReplayEvent* event) {
+    replay_record_event(get_simulation_tick(), event);
+    rollback_record_input(get_simulation_tick(), event);
+    apply_input_event(event);
+}
+
+static void input_queue_lock() {
+    while (!atomic_cas_i32(&g_input_queue_lock, 0, 1)) {
+    }
+}
+
+static void input_queue_unlock() {
+    atomic_store_i32(&g_input_queue_lock, 0);
+}
+
+static void queue_input_event(const ReplayEvent* event) {
+    // During a replay only the recording drives the game, Q still quits
+    if (replay_is_playing()) {
+        if (event->type == REPLAY_EVENT_KEY && event->action && (event->code == KEY_Q || event->code == 'Q')) {
+            quit_game();
+        }
+        return;
+    }
+    
+    input_queue_lock();
+    int queued = g_input_queue_count < INPUT_QUEUE_SIZE;
+    if (queued) {
+        g_input_queue[g_input_queue_count++] = *event;
+    }
+    input_queue_unlock();
+    
+    if (!queued) {
+        LOG_WARN(LOG_CATEGORY_INPUT, "Input queue full, event dropped");
+    }
+}
+
+static void apply_queued_input() {
+    ReplayEvent events[INPUT_QUEUE_SIZE];
+    
+    input_queue_lock();
+    int count = g_input_queue_count;
+    memcpy(events, g_input_queue, sizeof(ReplayEvent) * count);
+    g_input_queue_count = 0;
+    input_queue_unlock();
+    
+    for (int i = 0; i < count; i++) {
+        record_input_event(&events[i]);
+    }
+}
+
+void handle_keyboard_input(int key, int action) {
+    ReplayEvent event = { REPLAY_EVENT_KEY, key, action, 0.0f, 0.0f };
+    queue_input_event(&event);
+}
+
+void handle_mouse_movement(float x_offset, float y_offset) {
+    ReplayEvent event = { REPLAY_EVENT_MOUSE_MOVE, 0, 0, x_offset, y_offset };
+    queue_input_event(&event);
+}
+
+void handle_mouse_click(int button, int action) {
+    ReplayEvent event = { REPLAY_EVENT_MOUSE_CLICK, button, action, 0.0f, 0.0f };
+    queue_input_event(&event);
+}
+
+void process_input() {
+    if (!g_input_initialized) return;
+    
+    GameState* game_state = get_game_state();
+    if (!game_state) return;
+    
+    // Reset frame-specific input
+    g_input_state.jump_pressed = 0;
+    g_input_state.mouse_delta_x = 0.0f;
+    g_input_state.mouse_delta_y = 0.0f;
+    
+    // Process keyboard input, ticks run again by a rollback take theirs
+    // from its history and leave the queue for the next live tick
+    if (rollback_is_resimulating()) {
+        ReplayEvent event;
+        while (rollback_next_input(&event)) {
+            apply_input_event(&event);
+        }
+    } else if (replay_is_playing()) {
+        ReplayEvent event;
+        while (replay_next_event(get_simulation_tick(), &event)) {
+            apply_input_event(&event);
+        }
+        
+        // The terminal can still quit a replay
+        while (!g_scripted_input && kbhit()) {
+            int key = getch_nb();
+            if (key == KEY_Q || key == 'Q') {
+                game_state->game_running = 0;
+            }
+        }
+    } else {
+        apply_queued_input();
+        
+        while (!g_scripted_input && kbhit()) {
+            int key = getch_nb();
+            if (key > 0) {
+                ReplayEvent event = { REPLAY_EVENT_KEY, key, 1, 0.0f, 0.0f }; // Key pressed
+                record_input_event(&event);
+            }
+        }
+    }
+    
+    // Scripted input is part of the simulation, a replay runs it again
+    if (g_scripted_input) {
+        apply_scripted_input(game_state->delta_time);
+    }
+    
+    // Simulate mouse movement for testing (in real implementation, this would come from OS)
+    g_input_timers.mouse_time += game_state->delta_time;
+    
+    // Simulate slow mouse movement for camera rotation testing
+    float mouse_speed = 0.5f;
+    g_input_state.mouse_delta_x = sinf(g_input_timers.mouse_time * mouse_speed) * 0.1f;
+    g_input_state.mouse_delta_y = cosf(g_input_timers.mouse_time * mouse_speed * 0.7f) * 0.05f;
+    
+    // Simulate mouse clicks for shooting every 3 seconds
+    g_input_timers.shoot_timer += game_state->delta_time;
+    if (g_input_timers.shoot_timer >= 3.0f && game_state->current_phase == GAME_PLAYING) {
+        apply_mouse_click(0, 1); // Left mouse button click
+        g_input_timers.shoot_timer = 0.0f;
+    }
+    
+    // Update mouse position
+    g_input_state.mouse_x += g_input_state.mouse_delta_x;
+    g_input_state.mouse_y += g_input_state.mouse_delta_y;
+    
+    // Apply input to player movement
+    apply_input_to_player();
+}
+
 void apply_input_to_player() {
     GameState* game_state = get_game_state();
     if (!game_state || game_state->current_phase != GAME_PLAYING) {
@@ -250,8 +423,8 @@ void apply_input_to_player() {
     debug_timer += delta_time;
     if (debug_timer >= 1.0f) { // Every second
         if (player->speed > 12.0f) { // Only show when moving fast
-            printf("Bunny Hop Status - Speed: %.1f u/s, Ground: %s, Jumps: %d\n",
-                   player->speed, player->on_ground ? "YES" : "NO", player->consecutive_jumps);
+            LOG_DEBUG(LOG_CATEGORY_PHYSICS, "Bunny Hop Status - Speed: %.1f u/s, Ground: %s, Jumps: %d",
+                      player->speed, player->on_ground ? "YES" : "NO", player->consecutive_jumps);
         }
         debug_timer = 0.0f;
     }
@@ -286,6 +459,16 @@ InputState* get_input_state() {
     return &g_input_state;
 }
 
+void save_input_snapshot(InputSnapshot* snapshot) {
+    snapshot->state = g_input_state;
+    snapshot->timers = g_input_timers;
+}
+
+void load_input_snapshot(const InputSnapshot* snapshot) {
+    g_input_state = snapshot->state;
+    g_input_timers = snapshot->timers;
+}
+
 void fire_weapon() {
     GameState* game_state = get_game_state();
     if (!game_state || game_state->current_phase != GAME_PLAYING) {
@@ -296,7 +479,7 @@ void fire_weapon() {
     
     // Check if player has ammo
     if (player->ammo <= 0) {
-        printf("No ammo! Reload needed.\n");
+        LOG_DEBUG(LOG_CATEGORY_GAMEPLAY, "No ammo! Reload needed.");
         return;
     }
     
@@ -330,19 +513,24 @@ void fire_weapon() {
     int projectile_id = create_projectile(PROJECTILE_PLAYER_BULLET, spawn_pos, velocity, 0);
     
     if (projectile_id >= 0) {
-        // Play shooting sound
-        play_player_shoot_sound();
+        // Play shooting sound, a re-simulated shot already played it
+        int presented = !rollback_is_resimulating();
+        if (presented) {
+            play_player_shoot_sound();
+        }
         
         // Consume ammo
         player->ammo--;
-        printf("FIRE! Direction: (%.2f, %.2f, %.2f) Ammo: %d/%d\n", 
-               forward.x, forward.y, forward.z, player->ammo, player->max_ammo);
+        LOG_DEBUG(LOG_CATEGORY_GAMEPLAY, "FIRE! Direction: (%.2f, %.2f, %.2f) Ammo: %d/%d", 
+                  forward.x, forward.y, forward.z, player->ammo, player->max_ammo);
         
         // Auto-reload when empty
         if (player->ammo == 0) {
-            play_reload_sound();
+            if (presented) {
+                play_reload_sound();
+            }
             player->ammo = player->max_ammo;
-            printf("Auto-reload! Ammo: %d/%d\n", player->ammo, player->max_ammo);
+            LOG_DEBUG(LOG_CATEGORY_GAMEPLAY, "Auto-reload! Ammo: %d/%d", player->ammo, player->max_ammo);
         }
     }
 }
@@ -3,23 +3,45 @@
 
 #include "game_api.h"
 
+// Timers behind the scripted and simulated input, part of the simulation state
+typedef struct {
+    float script_time;
+    float jump_timer;
+    float fire_timer;
+    float mouse_time;
+    float shoot_timer;
+} InputTimers;
+
+typedef struct {
+    InputState state;
+    InputTimers timers;
+} InputSnapshot;
+
 // Input Manager functions
 void init_input_manager();
 void process_input();
 void cleanup_input_manager();
 
-// Input handling functions
+// Input handling functions. Events are queued from any thread and applied
+// (and recorded, see replay.h) at the start of the next tick's input.
 void handle_keyboard_input(int key, int action);
 void handle_mouse_movement(float x_offset, float y_offset);
 void handle_mouse_click(int button, int action);
 void apply_input_to_player();
 void fire_weapon();
 
+// Replace keyboard input with a fixed script (used by headless runs)
+void set_scripted_input(int enabled);
+
 // Input query functions
 int is_key_pressed(int key);
 int is_mouse_button_pressed(int button);
 InputState* get_input_state();
 
+// Saved and restored with game snapshots (snapshot.h)
+void save_input_snapshot(InputSnapshot* snapshot);
+void load_input_snapshot(const InputSnapshot* snapshot);
+
 // Settings functions
 void set_mouse_sensitivity(float sensitivity);
 float get_mouse_sensitivity();
@@ -0,0 +1,313 @@
+#include "job_system.h"
+#include "trace.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+typedef HANDLE job_thread_t;
+typedef CRITICAL_SECTION job_mutex_t;
+typedef CONDITION_VARIABLE job_cond_t;
+#define job_mutex_init(m) InitializeCriticalSection(m)
+#define job_mutex_destroy(m) DeleteCriticalSection(m)
+#define job_mutex_lock(m) EnterCriticalSection(m)
+#define job_mutex_unlock(m) LeaveCriticalSection(m)
+#define job_cond_init(c) InitializeConditionVariable(c)
+#define job_cond_destroy(c) ((void)(c))
+#define job_cond_wait(c, m) SleepConditionVariableCS(c, m, INFINITE)
+#define job_cond_broadcast(c) WakeAllConditionVariable(c)
+#define job_cond_signal(c) WakeConditionVariable(c)
+#else
+#include <pthread.h>
+#include <unistd.h>
+typedef pthread_t job_thread_t;
+typedef pthread_mutex_t job_mutex_t;
+typedef pthread_cond_t job_cond_t;
+#define job_mutex_init(m) pthread_mutex_init(m, NULL)
+#define job_mutex_destroy(m) pthread_mutex_destroy(m)
+#define job_mutex_lock(m) pthread_mutex_lock(m)
+#define job_mutex_unlock(m) pthread_mutex_unlock(m)
+#define job_cond_init(c) pthread_cond_init(c, NULL)
+#define job_cond_destroy(c) pthread_cond_destroy(c)
+#define job_cond_wait(c, m) pthread_cond_wait(c, m)
+#define job_cond_broadcast(c) pthread_cond_broadcast(c)
+#define job_cond_signal(c) pthread_cond_signal(c)
+#endif
+
+#define MAX_JOB_WORKERS 63
+
+// Chunk range owned by one thread. The owner takes from the front,
+// thieves take from the back.
+typedef struct {
+    job_mutex_t lock;
+    int next;
+    int end;
+} JobQueue;
+
+typedef struct {
+    int initialized;
+    int worker_count;
+    job_thread_t threads[MAX_JOB_WORKERS];
+    JobQueue queues[MAX_JOB_WORKERS + 1]; // Queue 0 belongs to the calling thread
+    
+    // Batch state, guarded by state_lock
+    job_mutex_t state_lock;
+    job_cond_t work_ready;
+    job_cond_t work_done;
+    int generation;
+    int shutdown;
+    int busy;
+    int pending_chunks;
+    
+    // Current batch, published before its chunks are queued
+    JobRangeFunc func;
+    void* user_data;
+    int count;
+    int chunk_size;
+} JobSystem;
+
+static JobSystem g_jobs;
+
+static int take_own_chunk(int self, int* chunk) {
+    JobQueue* queue = &g_jobs.queues[self];
+    int found = 0;
+    
+    job_mutex_lock(&queue->lock);
+    if (queue->next < queue->end) {
+        *chunk = queue->next++;
+        found = 1;
+    }
+    job_mutex_unlock(&queue->lock);
+    
+    return found;
+}
+
+static int steal_chunk(int self, int* chunk) {
+    int thread_count = g_jobs.worker_count + 1;
+    
+    for (int offset = 1; offset < thread_count; offset++) {
+        JobQueue* victim = &g_jobs.queues[(self + offset) % thread_count];
+        int found = 0;
+        
+        job_mutex_lock(&victim->lock);
+        if (victim->next < victim->end) {
+            *chunk = --victim->end;
+            found = 1;
+        }
+        job_mutex_unlock(&victim->lock);
+        
+        if (found) {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+// Run chunks until none are left anywhere, then report them as finished
+static void run_chunks(int self) {
+    int finished = 0;
+    int chunk;
+    
+    while (take_own_chunk(self, &chunk) || steal_chunk(self, &chunk)) {
+        int begin = chunk * g_jobs.chunk_size;
+        int end = begin + g_jobs.chunk_size;
+        if (end > g_jobs.count) {
+            end = g_jobs.count;
+        }
+        
+        TRACE_BEGIN("job_chunk");
+        g_jobs.func(g_jobs.user_data, begin, end, self);
+        TRACE_END();
+        finished++;
+    }
+    
+    if (finished > 0) {
+        job_mutex_lock(&g_jobs.state_lock);
+        g_jobs.pending_chunks -= finished;
+        if (g_jobs.pending_chunks == 0) {
+            job_cond_signal(&g_jobs.work_done);
+        }
+        job_mutex_unlock(&g_jobs.state_lock);
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI worker_main(LPVOID param) {
+#else
+static void* worker_main(void* param) {
+#endif
+    int self = (int)(size_t)param;
+    
+    char thread_name[32];
+    snprintf(thread_name, sizeof(thread_name), "worker %d", self);
+    trace_set_thread_name(thread_name);
+    
+    job_mutex_lock(&g_jobs.state_lock);
+    int seen_generation = g_jobs.generation;
+    
+    for (;;) {
+        while (!g_jobs.shutdown && g_jobs.generation == seen_generation) {
+            job_cond_wait(&g_jobs.work_ready, &g_jobs.state_lock);
+        }
+        if (g_jobs.shutdown) {
+            break;
+        }
+        
+        seen_generation = g_jobs.generation;
+        job_mutex_unlock(&g_jobs.state_lock);
+        
+        run_chunks(self);
+        
+        job_mutex_lock(&g_jobs.state_lock);
+    }
+    
+    job_mutex_unlock(&g_jobs.state_lock);
+    return 0;
+}
+
+static int detect_cpu_count() {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+#endif
+}
+
+void init_job_system(int worker_count) {
+    if (g_jobs.initialized) {
+        return;
+    }
+    
+    memset(&g_jobs, 0, sizeof(JobSystem));
+    
+    if (worker_count < 0) {
+        worker_count = detect_cpu_count() - 1;
+    }
+    if (worker_count > MAX_JOB_WORKERS) {
+        worker_count = MAX_JOB_WORKERS;
+    }
+    
+    job_mutex_init(&g_jobs.state_lock);
+    job_cond_init(&g_jobs.work_ready);
+    job_cond_init(&g_jobs.work_done);
+    for (int i = 0; i <= MAX_JOB_WORKERS; i++) {
+        job_mutex_init(&g_jobs.queues[i].lock);
+    }
+    
+    // Start workers one by one so a failure leaves a consistent count
+    for (int i = 0; i < worker_count; i++) {
+        void* param = (void*)(size_t)(i + 1);
+#ifdef _WIN32
+        g_jobs.threads[i] = CreateThread(NULL, 0, worker_main, param, 0, NULL);
+        int started = g_jobs.threads[i] != NULL;
+#else
+        int started = pthread_create(&g_jobs.threads[i], NULL, worker_main, param) == 0;
+#endif
+        if (!started) {
+            printf("Job system: failed to start worker %d\n", i + 1);
+            break;
+        }
+        g_jobs.worker_count++;
+    }
+    
+    g_jobs.initialized = 1;
+    printf("Job system initialized with %d worker threads\n", g_jobs.worker_count);
+}
+
+void cleanup_job_system() {
+    if (!g_jobs.initialized) {
+        return;
+    }
+    
+    job_mutex_lock(&g_jobs.state_lock);
+    g_jobs.shutdown = 1;
+    job_cond_broadcast(&g_jobs.work_ready);
+    job_mutex_unlock(&g_jobs.state_lock);
+    
+    for (int i = 0; i < g_jobs.worker_count; i++) {
+#ifdef _WIN32
+        WaitForSingleObject(g_jobs.threads[i], INFINITE);
+        CloseHandle(g_jobs.threads[i]);
+#else
+        pthread_join(g_jobs.threads[i], NULL);
+#endif
+    }
+    
+    for (int i = 0; i <= MAX_JOB_WORKERS; i++) {
+        job_mutex_destroy(&g_jobs.queues[i].lock);
+    }
+    job_cond_destroy(&g_jobs.work_done);
+    job_cond_destroy(&g_jobs.work_ready);
+    job_mutex_destroy(&g_jobs.state_lock);
+    
+    memset(&g_jobs, 0, sizeof(JobSystem));
+    printf("Job system cleaned up\n");
+}
+
+int job_system_thread_count() {
+    return g_jobs.worker_count + 1;
+}
+
+void job_system_parallel_for(int count, int chunk_size, JobRangeFunc func, void* user_data) {
+    if (count <= 0 || !func) {
+        return;
+    }
+    if (chunk_size <= 0) {
+        chunk_size = 1;
+    }
+    
+    int chunk_count = (count + chunk_size - 1) / chunk_size;
+    int run_inline = !g_jobs.initialized || g_jobs.worker_count == 0 || chunk_count == 1;
+    
+    if (!run_inline) {
+        job_mutex_lock(&g_jobs.state_lock);
+        run_inline = g_jobs.busy;
+        g_jobs.busy = 1;
+        job_mutex_unlock(&g_jobs.state_lock);
+    }
+    
+    if (run_inline) {
+        func(user_data, 0, count, 0);
+        return;
+    }
+    
+    g_jobs.func = func;
+    g_jobs.user_data = user_data;
+    g_jobs.count = count;
+    g_jobs.chunk_size = chunk_size;
+    
+    // Count the chunks in before queueing them, since a worker still
+    // scanning from the previous batch may pick them up right away
+    job_mutex_lock(&g_jobs.state_lock);
+    g_jobs.pending_chunks = chunk_count;
+    job_mutex_unlock(&g_jobs.state_lock);
+    
+    // Hand each thread an even share of the chunks
+    int thread_count = g_jobs.worker_count + 1;
+    for (int i = 0; i < thread_count; i++) {
+        JobQueue* queue = &g_jobs.queues[i];
+        job_mutex_lock(&queue->lock);
+        queue->next = (int)((long long)chunk_count * i / thread_count);
+        queue->end = (int)((long long)chunk_count * (i + 1) / thread_count);
+        job_mutex_unlock(&queue->lock);
+    }
+    
+    job_mutex_lock(&g_jobs.state_lock);
+    g_jobs.generation++;
+    job_cond_broadcast(&g_jobs.work_ready);
+    job_mutex_unlock(&g_jobs.state_lock);
+    
+    // The calling thread works too, then waits for stragglers
+    run_chunks(0);
+    
+    job_mutex_lock(&g_jobs.state_lock);
+    while (g_jobs.pending_chunks > 0) {
+        job_cond_wait(&g_jobs.work_done, &g_jobs.state_lock);
+    }
+    g_jobs.busy = 0;
+    job_mutex_unlock(&g_jobs.state_lock);
+}
@@ -0,0 +1,29 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Processes items [begin, end). worker_index is 0 for the calling thread
+// and 1..worker_count for pool threads, usable for per-worker scratch data.
+typedef void (*JobRangeFunc)(void* user_data, int begin, int end, int worker_index);
+
+// Job system lifetime. worker_count < 0 picks one worker per extra CPU core;
+// 0 keeps everything on the calling thread.
+void init_job_system(int worker_count);
+void cleanup_job_system();
+
+// Number of threads that take part in a parallel_for, including the caller
+int job_system_thread_count();
+
+// Split [0, count) into chunks of chunk_size and run them on the workers and
+// the calling thread, returning once every chunk has finished. Idle threads
+// steal chunks from busy ones. Nested calls run inline on the calling thread.
+void job_system_parallel_for(int count, int chunk_size, JobRangeFunc func, void* user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // JOB_SYSTEM_H
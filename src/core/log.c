@@ -0,0 +1,462 @@
+#include "log.h"
+#include "atomics.h"
+#include "timer.h"
+#include <stdio.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#define LOG_RING_CAPACITY 4096 // Records, power of two
+#define LOG_MAX_ARGS 8
+#define LOG_STRING_BYTES 112   // Inline storage for %s arguments
+#define LOG_LINE_BYTES 512
+
+typedef enum {
+    LOG_ARG_INT,
+    LOG_ARG_UINT,
+    LOG_ARG_DOUBLE,
+    LOG_ARG_STRING,     // Offset into LogRecord.strings
+    LOG_ARG_POINTER
+} LogArgType;
+
+typedef union {
+    long long i;
+    unsigned long long u;
+    double d;
+    const void* p;
+} LogArg;
+
+// Fixed-size record, formatted by the writer thread
+typedef struct {
+    double timestamp;
+    const char* format;
+    unsigned char level;
+    unsigned char category;
+    unsigned char arg_count;
+    unsigned char string_used;
+    unsigned char arg_types[LOG_MAX_ARGS];
+    LogArg args[LOG_MAX_ARGS];
+    char strings[LOG_STRING_BYTES];
+} LogRecord;
+
+// Bounded MPMC queue: a cell is free for the producer at position pos when
+// its sequence equals pos, and ready for the consumer when it equals pos + 1
+typedef struct {
+    volatile int64_t sequence;
+    LogRecord record;
+} LogCell;
+
+typedef struct {
+    LogCell cells[LOG_RING_CAPACITY];
+    
+    // Producer and consumer cursors live on separate cache lines
+    volatile int64_t enqueue_pos;
+    char pad0[64 - sizeof(int64_t)];
+    volatile int64_t dequeue_pos;
+    char pad1[64 - sizeof(int64_t)];
+    
+    volatile int64_t dropped;
+    volatile int32_t running;
+    volatile int32_t stop;
+    int level;
+    unsigned int category_mask;
+    double start_time;
+#ifdef _WIN32
+    HANDLE thread;
+#else
+    pthread_t thread;
+#endif
+} LogState;
+
+static LogState g_log = {
+    .level = LOG_LEVEL_TRACE,
+    .category_mask = LOG_CATEGORY_ALL
+};
+
+static const char* g_level_names[] = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR"};
+static const char* g_category_names[LOG_CATEGORY_COUNT] = {
+    "core", "gameplay", "ai", "input", "physics", "audio", "graphics", "ui"
+};
+
+// Walk one conversion spec starting after '%'. Returns a pointer past it and
+// fills in the parts needed to re-emit it with a normalized length modifier.
+typedef struct {
+    const char* flags_begin;    // Flags, width and precision
+    size_t flags_length;
+    char length[3];             // Length modifier as written
+    char conversion;
+} LogSpec;
+
+static const char* parse_spec(const char* p, LogSpec* spec) {
+    spec->flags_begin = p;
+    while (*p && strchr("-+ #0123456789.", *p)) {
+        p++;
+    }
+    spec->flags_length = (size_t)(p - spec->flags_begin);
+    
+    size_t length = 0;
+    while (*p && strchr("hlzjtL", *p) && length < 2) {
+        spec->length[length++] = *p++;
+    }
+    spec->length[length] = '\0';
+    spec->conversion = *p ? *p++ : '\0';
+    return p;
+}
+
+static LogArgType arg_type_for(char conversion) {
+    switch (conversion) {
+        case 'd': case 'i': case 'c':
+            return LOG_ARG_INT;
+        case 'u': case 'o': case 'x': case 'X':
+            return LOG_ARG_UINT;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            return LOG_ARG_DOUBLE;
+        case 's':
+            return LOG_ARG_STRING;
+        default:
+            return LOG_ARG_POINTER;
+    }
+}
+
+// Pull the arguments out of the va_list by walking the format string
+static void capture_args(LogRecord* record, const char* format, va_list args) {
+    const char* p = format;
+    
+    while ((p = strchr(p, '%')) != NULL && record->arg_count < LOG_MAX_ARGS) {
+        p++;
+        if (*p == '%') {
+            p++;
+            continue;
+        }
+        
+        LogSpec spec;
+        p = parse_spec(p, &spec);
+        if (spec.conversion == '\0' || spec.conversion == 'n') {
+            break;
+        }
+        
+        int slot = record->arg_count++;
+        LogArgType type = arg_type_for(spec.conversion);
+        LogArg* arg = &record->args[slot];
+        record->arg_types[slot] = (unsigned char)type;
+        
+        switch (type) {
+            case LOG_ARG_INT:
+                if (strcmp(spec.length, "ll") == 0) arg->i = va_arg(args, long long);
+                else if (strcmp(spec.length, "l") == 0) arg->i = va_arg(args, long);
+                else if (strcmp(spec.length, "z") == 0) arg->i = (long long)va_arg(args, size_t);
+                else if (strcmp(spec.length, "t") == 0) arg->i = va_arg(args, ptrdiff_t);
+                else if (strcmp(spec.length, "j") == 0) arg->i = va_arg(args, long long);
+                else arg->i = va_arg(args, int);
+                break;
+            case LOG_ARG_UINT:
+                if (strcmp(spec.length, "ll") == 0) arg->u = va_arg(args, unsigned long long);
+                else if (strcmp(spec.length, "l") == 0) arg->u = va_arg(args, unsigned long);
+                else if (strcmp(spec.length, "z") == 0) arg->u = va_arg(args, size_t);
+                else if (strcmp(spec.length, "t") == 0) arg->u = (unsigned long long)va_arg(args, ptrdiff_t);
+                else if (strcmp(spec.length, "j") == 0) arg->u = va_arg(args, unsigned long long);
+                else arg->u = va_arg(args, unsigned int);
+                break;
+            case LOG_ARG_DOUBLE:
+                if (strcmp(spec.length, "L") == 0) arg->d = (double)va_arg(args, long double);
+                else arg->d = va_arg(args, double);
+                break;
+            case LOG_ARG_STRING: {
+                const char* text = va_arg(args, const char*);
+                if (!text) {
+                    text = "(null)";
+                }
+                size_t available = LOG_STRING_BYTES - record->string_used;
+                size_t length = strlen(text);
+                if (available == 0) {
+                    arg->i = -1;
+                    break;
+                }
+                if (length >= available) {
+                    length = available - 1;
+                }
+                memcpy(record->strings + record->string_used, text, length);
+                record->strings[record->string_used + length] = '\0';
+                arg->i = record->string_used;
+                record->string_used = (unsigned char)(record->string_used + length + 1);
+                break;
+            }
+            case LOG_ARG_POINTER:
+                arg->p = va_arg(args, void*);
+                break;
+        }
+    }
+}
+
+// Expand a record into text, one conversion at a time
+static size_t format_record(const LogRecord* record, char* out, size_t size) {
+    int written = snprintf(out, size, "[%9.3f] %-5s %-8s ",
+                           record->timestamp,
+                           g_level_names[record->level < LOG_LEVEL_NONE ? record->level : LOG_LEVEL_ERROR],
+                           record->category < LOG_CATEGORY_COUNT ? g_category_names[record->category] : "?");
+    size_t used = written > 0 ? (size_t)written : 0;
+    
+    const char* p = record->format;
+    int arg_index = 0;
+    
+    while (*p && used + 1 < size) {
+        if (*p != '%') {
+            out[used++] = *p++;
+            continue;
+        }
+        
+        const char* spec_start = p++;
+        if (*p == '%') {
+            out[used++] = '%';
+            p++;
+            continue;
+        }
+        
+        LogSpec spec;
+        p = parse_spec(p, &spec);
+        
+        if (arg_index >= record->arg_count) {
+            // Arguments past LOG_MAX_ARGS: print the spec itself
+            size_t length = (size_t)(p - spec_start);
+            if (length > size - used - 1) {
+                length = size - used - 1;
+            }
+            memcpy(out + used, spec_start, length);
+            used += length;
+            continue;
+        }
+        
+        // Rebuild the spec with a length modifier matching the stored type
+        char format[32];
+        size_t flags = spec.flags_length < 16 ? spec.flags_length : 16;
+        format[0] = '%';
+        memcpy(format + 1, spec.flags_begin, flags);
+        size_t f = 1 + flags;
+        
+        const LogArg* arg = &record->args[arg_index];
+        LogArgType type = (LogArgType)record->arg_types[arg_index];
+        arg_index++;
+        
+        if ((type == LOG_ARG_INT || type == LOG_ARG_UINT) && spec.conversion != 'c') {
+            format[f++] = 'l';
+            format[f++] = 'l';
+        }
+        format[f++] = spec.conversion;
+        format[f] = '\0';
+        
+        size_t remaining = size - used;
+        switch (type) {
+            case LOG_ARG_INT:
+                written = spec.conversion == 'c' ? snprintf(out + used, remaining, format, (int)arg->i)
+                                                 : snprintf(out + used, remaining, format, arg->i);
+                break;
+            case LOG_ARG_UINT:
+                written = snprintf(out + used, remaining, format, arg->u);
+                break;
+            case LOG_ARG_DOUBLE:
+                written = snprintf(out + used, remaining, format, arg->d);
+                break;
+            case LOG_ARG_STRING:
+                written = snprintf(out + used, remaining, format,
+                                   arg->i >= 0 ? record->strings + arg->i : "");
+                break;
+            default:
+                written = snprintf(out + used, remaining, format, arg->p);
+                break;
+        }
+        
+        if (written > 0) {
+            used += (size_t)written < remaining ? (size_t)written : remaining - 1;
+        }
+    }
+    
+    if (used + 1 >= size) {
+        used = size - 2;
+    }
+    out[used++] = '\n';
+    out[used] = '\0';
+    return used;
+}
+
+static int enqueue_record(const LogRecord* record) {
+    int64_t pos = atomic_load_i64(&g_log.enqueue_pos);
+    LogCell* cell;
+    
+    for (;;) {
+        cell = &g_log.cells[pos & (LOG_RING_CAPACITY - 1)];
+        int64_t sequence = atomic_load_i64(&cell->sequence);
+        int64_t diff = sequence - pos;
+        
+        if (diff == 0) {
+            if (atomic_cas_i64(&g_log.enqueue_pos, pos, pos + 1)) {
+                break;
+            }
+            pos = atomic_load_i64(&g_log.enqueue_pos);
+        } else if (diff < 0) {
+            // Full - drop rather than stall the game
+            return 0;
+        } else {
+            pos = atomic_load_i64(&g_log.enqueue_pos);
+        }
+    }
+    
+    cell->record = *record;
+    atomic_store_i64(&cell->sequence, pos + 1);
+    return 1;
+}
+
+// Single consumer: format and write everything queued so far
+static int drain_records() {
+    char line[LOG_LINE_BYTES];
+    int drained = 0;
+    
+    for (;;) {
+        int64_t pos = g_log.dequeue_pos;
+        LogCell* cell = &g_log.cells[pos & (LOG_RING_CAPACITY - 1)];
+        if (atomic_load_i64(&cell->sequence) != pos + 1) {
+            break;
+        }
+        
+        size_t length = format_record(&cell->record, line, sizeof(line));
+        atomic_store_i64(&cell->sequence, pos + LOG_RING_CAPACITY);
+        atomic_store_i64(&g_log.dequeue_pos, pos + 1);
+        
+        fwrite(line, 1, length, stdout);
+        drained++;
+    }
+    
+    if (drained > 0) {
+        fflush(stdout);
+    }
+    return drained;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI log_writer_main(LPVOID param) {
+#else
+static void* log_writer_main(void* param) {
+#endif
+    (void)param;
+    
+    while (!atomic_load_i32(&g_log.stop)) {
+        if (drain_records() == 0) {
+            sleep_ms(1);
+        }
+    }
+    drain_records();
+    return 0;
+}
+
+void init_log() {
+    if (g_log.running) {
+        return;
+    }
+    
+    for (int i = 0; i < LOG_RING_CAPACITY; i++) {
+        g_log.cells[i].sequence = i;
+    }
+    g_log.enqueue_pos = 0;
+    g_log.dequeue_pos = 0;
+    g_log.dropped = 0;
+    g_log.stop = 0;
+    if (g_log.start_time == 0.0) {
+        g_log.start_time = get_current_time();
+    }
+
+#ifdef _WIN32
+    g_log.thread = CreateThread(NULL, 0, log_writer_main, NULL, 0, NULL);
+    int started = g_log.thread != NULL;
+#else
+    int started = pthread_create(&g_log.thread, NULL, log_writer_main, NULL) == 0;
+#endif
+    if (!started) {
+        printf("Log: failed to start writer thread, logging synchronously\n");
+        return;
+    }
+    
+    atomic_store_i32(&g_log.running, 1);
+}
+
+void cleanup_log() {
+    if (!g_log.running) {
+        return;
+    }
+    
+    atomic_store_i32(&g_log.stop, 1);
+#ifdef _WIN32
+    WaitForSingleObject(g_log.thread, INFINITE);
+    CloseHandle(g_log.thread);
+#else
+    pthread_join(g_log.thread, NULL);
+#endif
+    atomic_store_i32(&g_log.running, 0);
+    
+    if (g_log.dropped > 0) {
+        printf("Log: %lld messages dropped (ring buffer full)\n", (long long)g_log.dropped);
+    }
+}
+
+void log_set_level(int level) {
+    g_log.level = level;
+}
+
+void log_set_category_mask(unsigned int mask) {
+    g_log.category_mask = mask;
+}
+
+void log_flush() {
+    if (!atomic_load_i32(&g_log.running)) {
+        return;
+    }
+    
+    int64_t target = atomic_load_i64(&g_log.enqueue_pos);
+    while (atomic_load_i64(&g_log.dequeue_pos) < target) {
+        sleep_ms(1);
+    }
+}
+
+unsigned long log_dropped_count() {
+    return (unsigned long)atomic_load_i64(&g_log.dropped);
+}
+
+void log_write(int level, LogCategory category, const char* format, ...) {
+    if (level < g_log.level || level >= LOG_LEVEL_NONE ||
+        !(g_log.category_mask & (1u << category))) {
+        return;
+    }
+    
+    if (g_log.start_time == 0.0) {
+        g_log.start_time = get_current_time();
+    }
+    
+    LogRecord record;
+    record.timestamp = get_current_time() - g_log.start_time;
+    record.format = format;
+    record.level = (unsigned char)level;
+    record.category = (unsigned char)category;
+    record.arg_count = 0;
+    record.string_used = 0;
+    
+    va_list args;
+    va_start(args, format);
+    capture_args(&record, format, args);
+    va_end(args);
+    
+    if (atomic_load_i32(&g_log.running)) {
+        if (!enqueue_record(&record)) {
+            atomic_add_i64(&g_log.dropped, 1);
+        }
+        return;
+    }
+    
+    // No writer thread: format here
+    char line[LOG_LINE_BYTES];
+    size_t length = format_record(&record, line, sizeof(line));
+    fwrite(line, 1, length, stdout);
+}
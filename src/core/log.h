@@ -0,0 +1,97 @@
+#ifndef LOG_H
+#define LOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Log levels, lowest to highest severity
+#define LOG_LEVEL_TRACE 0
+#define LOG_LEVEL_DEBUG 1
+#define LOG_LEVEL_INFO  2
+#define LOG_LEVEL_WARN  3
+#define LOG_LEVEL_ERROR 4
+#define LOG_LEVEL_NONE  5
+
+// Calls below this level compile to nothing. Release builds keep INFO and up.
+#ifndef LOG_COMPILE_LEVEL
+#ifdef NDEBUG
+#define LOG_COMPILE_LEVEL LOG_LEVEL_INFO
+#else
+#define LOG_COMPILE_LEVEL LOG_LEVEL_DEBUG
+#endif
+#endif
+
+typedef enum {
+    LOG_CATEGORY_CORE,
+    LOG_CATEGORY_GAMEPLAY,
+    LOG_CATEGORY_AI,
+    LOG_CATEGORY_INPUT,
+    LOG_CATEGORY_PHYSICS,
+    LOG_CATEGORY_AUDIO,
+    LOG_CATEGORY_GRAPHICS,
+    LOG_CATEGORY_UI,
+    LOG_CATEGORY_COUNT
+} LogCategory;
+
+#define LOG_CATEGORY_ALL ((1u << LOG_CATEGORY_COUNT) - 1)
+
+// Start and stop the background writer. Before init_log() and after
+// cleanup_log(), messages are formatted and printed on the calling thread.
+void init_log();
+void cleanup_log();
+
+// Runtime filters on top of LOG_COMPILE_LEVEL
+void log_set_level(int level);
+void log_set_category_mask(unsigned int mask);
+
+// Block until every queued message has been written
+void log_flush();
+
+// Messages lost because the ring buffer was full
+unsigned long log_dropped_count();
+
+// Queue one message. format must be a string literal (it is read later by
+// the writer thread). Up to 8 arguments are kept and %s strings are copied,
+// truncated to fit the record. '*' widths are not supported. No trailing
+// newline is needed.
+#if defined(__GNUC__)
+__attribute__((format(printf, 3, 4)))
+#endif
+void log_write(int level, LogCategory category, const char* format, ...);
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_TRACE
+#define LOG_TRACE(category, ...) log_write(LOG_LEVEL_TRACE, category, __VA_ARGS__)
+#else
+#define LOG_TRACE(category, ...) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(category, ...) log_write(LOG_LEVEL_DEBUG, category, __VA_ARGS__)
+#else
+#define LOG_DEBUG(category, ...) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(category, ...) log_write(LOG_LEVEL_INFO, category, __VA_ARGS__)
+#else
+#define LOG_INFO(category, ...) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_WARN
+#define LOG_WARN(category, ...) log_write(LOG_LEVEL_WARN, category, __VA_ARGS__)
+#else
+#define LOG_WARN(category, ...) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(category, ...) log_write(LOG_LEVEL_ERROR, category, __VA_ARGS__)
+#else
+#define LOG_ERROR(category, ...) ((void)0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LOG_H
@@ -2,6 +2,15 @@
 #include "game_state.h"
 #include "enemy_ai.h"
 #include "collision_system.h"
+#include "entity_pool.h"
+#include "projectile_soa.h"
+#include "job_system.h"
+#include "timer.h"
+#include "flow_field.h"
+#include "log.h"
+#include "trace.h"
+#include "rng.h"
+#include "rollback.h"
 #include "../audio_bridge.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -26,7 +35,71 @@ static Vector3 enemy_spawn_points[] = {
 
 static int num_spawn_points = sizeof(enemy_spawn_points) / sizeof(Vector3);
 
+// Downward acceleration on projectiles (reduced for faster projectiles)
+#define PROJECTILE_GRAVITY 5.0f
+
+// Hot projectile data, dense in projectile_pool.alive order
+static ProjectileSoA g_projectile_soa;
+
+// Broadphase over live enemies, keyed by enemy slot. Cells are sized to
+// comfortably hold the largest enemy collision sphere. Query results go to
+// a max_enemies scratch list, so no query can be cut short.
+#define ENEMY_HASH_CELL_SIZE 2.0f
+static SpatialHash g_enemy_hash;
+static int* g_broadphase_candidates = NULL;
+
+// AI components stored inline, indexed by enemy slot
+static EnemyAI* g_enemy_ai = NULL;
+
+// AI level of detail: near enemies think every tick, farther ones every Nth
+// tick. Each enemy is offset by its slot so a tier's updates are spread over
+// ticks instead of all landing on the same one.
+#define AI_LOD_NEAR_DISTANCE 15.0f
+#define AI_LOD_MID_DISTANCE 30.0f
+#define AI_LOD_MID_INTERVAL 4
+#define AI_LOD_FAR_INTERVAL 8
+
+// Wall-clock budget shared by the mid/far tier updates each tick
+#define AI_DEFAULT_TIME_BUDGET 0.002
+#define AI_MIN_DEFERRED_UPDATES 8
+
+static int* g_ai_batch = NULL;              // Enemy slots updated this tick
+static unsigned int g_ai_tick = 0;
+static int g_ai_cursor = 0;                 // Round-robin start in the alive list
+static double g_ai_time_budget = AI_DEFAULT_TIME_BUDGET;
+static double g_ai_update_cost = 0.0;       // Moving average, seconds per AI update
+static int g_ai_deterministic = 0;          // Ignore the budget, serve every due enemy
+
+#define DEFAULT_SPAWN_INTERVAL 10.0f
+#define MIN_SPAWN_INTERVAL 5.0f
+
+static float g_spawn_timer = 0.0f;
+static float g_spawn_interval = DEFAULT_SPAWN_INTERVAL;
+
+size_t object_manager_storage_size(int max_enemies, int max_projectiles) {
+    // EnemyAI table, AI batch and broadphase candidates, each padded up to
+    // the default alignment
+    return projectile_soa_storage_size(max_projectiles) +
+           spatial_hash_storage_size(max_enemies) +
+           (size_t)max_enemies * (sizeof(EnemyAI) + 2 * sizeof(int)) +
+           3 * ARENA_DEFAULT_ALIGNMENT;
+}
+
 void init_object_manager() {
+    GameState* game_state = get_game_state();
+    
+    projectile_soa_init(&g_projectile_soa, game_state->max_projectiles, get_level_arena());
+    spatial_hash_init(&g_enemy_hash, ENEMY_HASH_CELL_SIZE, game_state->max_enemies, get_level_arena());
+    g_enemy_ai = (EnemyAI*)arena_alloc_zeroed(get_level_arena(), sizeof(EnemyAI) * game_state->max_enemies, 0);
+    g_ai_batch = (int*)arena_alloc(get_level_arena(), sizeof(int) * game_state->max_enemies, 0);
+    g_broadphase_candidates = (int*)arena_alloc(get_level_arena(), sizeof(int) * game_state->max_enemies, 0);
+    g_ai_tick = 0;
+    g_ai_cursor = 0;
+    g_ai_update_cost = 0.0;
+    g_spawn_timer = 0.0f;
+    g_spawn_interval = DEFAULT_SPAWN_INTERVAL;
+    init_flow_field();
+    
     printf("Object Manager initialized\n");
 }
 
@@ -34,16 +107,17 @@ void init_object_manager() {
 int create_enemy(EnemyType type, Vector3 position) {
     GameState* game_state = get_game_state();
     
-    if (game_state->enemy_count >= MAX_ENEMIES) {
-        printf("Cannot create enemy: maximum limit reached (%d)\n", MAX_ENEMIES);
-        return -1;
+    int enemy_id = entity_pool_acquire(&game_state->enemy_pool);
+    if (enemy_id == INVALID_ENTITY_HANDLE) {
+        LOG_WARN(LOG_CATEGORY_GAMEPLAY, "Cannot create enemy: maximum limit reached (%d)", game_state->enemy_pool.capacity);
+        return INVALID_ENTITY_HANDLE;
     }
     
-    int enemy_id = game_state->enemy_count;
-    Enemy* enemy = &game_state->enemies[enemy_id];
+    Enemy* enemy = &game_state->enemies[entity_handle_slot(enemy_id)];
     
     // Initialize enemy
     enemy->position = position;
+    enemy->previous_position = position;
     enemy->velocity = (Vector3){0.0f, 0.0f, 0.0f};
     enemy->target_position = game_state->player.position;
     enemy->type = type;
@@ -51,11 +125,11 @@ int create_enemy(EnemyType type, Vector3 position) {
     enemy->last_attack_time = 0.0f;
     enemy->is_active = 1;
     
-    // Allocate and initialize AI component
-    enemy->ai = malloc(sizeof(EnemyAI));
+    // Initialize the AI component in the enemy's slot
+    enemy->ai = g_enemy_ai ? &g_enemy_ai[entity_handle_slot(enemy_id)] : NULL;
     if (enemy->ai) {
-        EnemyType ai_type = (type == ENEMY_BASIC) ? ENEMY_TYPE_BASIC :
-                           (type == ENEMY_FAST) ? ENEMY_TYPE_FAST : ENEMY_TYPE_HEAVY;
+        EnemyAIType ai_type = (type == ENEMY_BASIC) ? ENEMY_TYPE_BASIC :
+                             (type == ENEMY_FAST) ? ENEMY_TYPE_FAST : ENEMY_TYPE_HEAVY;
         enemy_ai_init(enemy->ai, ai_type);
     }
     
@@ -80,39 +154,152 @@ int create_enemy(EnemyType type, Vector3 position) {
             break;
     }
     
-    game_state->enemy_count++;
+    game_state->enemy_count = game_state->enemy_pool.count;
     
-    printf("Created %s enemy with AI at (%.2f, %.2f, %.2f) - ID: %d\n",
-           type == ENEMY_BASIC ? "BASIC" : 
-           type == ENEMY_FAST ? "FAST" : "HEAVY",
-           position.x, position.y, position.z, enemy_id);
+    LOG_DEBUG(LOG_CATEGORY_GAMEPLAY, "Created %s enemy with AI at (%.2f, %.2f, %.2f) - ID: %d",
+              type == ENEMY_BASIC ? "BASIC" : 
+              type == ENEMY_FAST ? "FAST" : "HEAVY",
+              position.x, position.y, position.z, enemy_id);
     
     return enemy_id;
 }
 
+// Enemies per job in the parallel AI pass
+#define ENEMY_AI_CHUNK_SIZE 32
+
+// Read phase: AI decisions only touch the enemy and its own AI component
+static void update_enemy_ai_range(void* user_data, int begin, int end, int worker_index) {
+    GameState* game_state = (GameState*)user_data;
+    (void)worker_index;
+    
+    for (int i = begin; i < end; i++) {
+        Enemy* enemy = &game_state->enemies[g_ai_batch[i]];
+        
+        // Catch up on all the time since this enemy last thought
+        float delta_time = enemy->ai->pending_dt;
+        enemy->ai->pending_dt = 0.0f;
+        enemy_ai_update(enemy->ai, enemy, &game_state->player, delta_time);
+        
+        // Sync AI health with enemy health
+        enemy->health = enemy->ai->health;
+        
+        // Update legacy ai_state for compatibility
+        switch (enemy->ai->state) {
+            case AI_STATE_IDLE: enemy->ai_state = AI_PATROL; break;
+            case AI_STATE_CHASING: enemy->ai_state = AI_CHASE; break;
+            case AI_STATE_ATTACKING: enemy->ai_state = AI_ATTACK; break;
+            case AI_STATE_DEAD: enemy->ai_state = AI_DEAD; break;
+        }
+    }
+}
+
+// Pick the enemies whose AI runs this tick and store their slots in g_ai_batch
+static int schedule_enemy_ai(GameState* game_state, float delta_time) {
+    EntityPool* pool = &game_state->enemy_pool;
+    Vector3 player_position = game_state->player.position;
+    int batch_count = 0;
+    
+    if (!g_ai_batch) {
+        return 0;
+    }
+    
+    g_ai_tick++;
+    
+    // Near enemies always update; mid/far ones become due on their tick
+    for (int i = 0; i < pool->count; i++) {
+        int slot = pool->alive[i];
+        Enemy* enemy = &game_state->enemies[slot];
+        EnemyAI* ai = enemy->ai;
+        if (!ai || !enemy->is_active || enemy->ai_state == AI_DEAD) continue;
+        
+        ai->pending_dt += delta_time;
+        
+        float distance_sq = vector3_distance_squared(enemy->position, player_position);
+        if (distance_sq <= AI_LOD_NEAR_DISTANCE * AI_LOD_NEAR_DISTANCE) {
+            ai->update_due = 0;
+            g_ai_batch[batch_count++] = slot;
+        } else {
+            unsigned int interval = distance_sq <= AI_LOD_MID_DISTANCE * AI_LOD_MID_DISTANCE ?
+                                    AI_LOD_MID_INTERVAL : AI_LOD_FAR_INTERVAL;
+            if ((g_ai_tick + (unsigned int)slot) % interval == 0) {
+                ai->update_due = 1;
+            }
+        }
+    }
+    
+    // Turn what is left of the time budget into a number of due updates
+    int allowed = pool->count;
+    if (g_ai_update_cost > 0.0 && !g_ai_deterministic) {
+        allowed = (int)((g_ai_time_budget - g_ai_update_cost * batch_count) / g_ai_update_cost);
+        if (allowed < AI_MIN_DEFERRED_UPDATES) {
+            allowed = AI_MIN_DEFERRED_UPDATES;
+        }
+    }
+    
+    // Serve due enemies round-robin; the rest stay due and keep accumulating time
+    int scanned = 0;
+    while (scanned < pool->count && allowed > 0) {
+        int slot = pool->alive[(g_ai_cursor + scanned) % pool->count];
+        EnemyAI* ai = game_state->enemies[slot].ai;
+        scanned++;
+        
+        if (ai && ai->update_due) {
+            ai->update_due = 0;
+            g_ai_batch[batch_count++] = slot;
+            allowed--;
+        }
+    }
+    g_ai_cursor = pool->count > 0 ? (g_ai_cursor + scanned) % pool->count : 0;
+    
+    return batch_count;
+}
+
+void set_ai_time_budget(double seconds) {
+    g_ai_time_budget = seconds > 0.0 ? seconds : AI_DEFAULT_TIME_BUDGET;
+}
+
+void set_deterministic_ai(int enabled) {
+    g_ai_deterministic = enabled;
+}
+
 void update_enemies(float delta_time) {
     GameState* game_state = get_game_state();
+    EntityPool* pool = &game_state->enemy_pool;
     
-    for (int i = 0; i < game_state->enemy_count; i++) {
-        Enemy* enemy = &game_state->enemies[i];
+    // One path query for every chasing enemy, rebuilt over a few ticks when the player changes cell
+    TRACE_BEGIN("flow_field_update");
+    flow_field_update(game_state->player.position);
+    TRACE_END();
+    
+    int batch_count = schedule_enemy_ai(game_state, delta_time);
+    
+    if (batch_count > 0) {
+        TRACE_BEGIN("enemy_ai_jobs");
+        double start_time = get_current_time();
+        job_system_parallel_for(batch_count, ENEMY_AI_CHUNK_SIZE, update_enemy_ai_range, game_state);
+        
+        double cost = (get_current_time() - start_time) / batch_count;
+        g_ai_update_cost = g_ai_update_cost > 0.0 ? g_ai_update_cost * 0.9 + cost * 0.1 : cost;
+        TRACE_END();
+    }
+    
+    TRACE_BEGIN("enemy_commit");
+    // Commit phase: apply side effects serially in alive-list order so the
+    // outcome does not depend on how the AI pass was scheduled. Walk backwards
+    // so dead enemies can be released in place.
+    for (int i = pool->count - 1; i >= 0; i--) {
+        int slot = pool->alive[i];
+        Enemy* enemy = &game_state->enemies[slot];
         
         if (!enemy->is_active || enemy->ai_state == AI_DEAD) {
+            remove_enemy(entity_pool_handle_for_slot(pool, slot));
             continue;
         }
         
-        // Use new AI system if available
         if (enemy->ai) {
-            enemy_ai_update(enemy->ai, enemy, &game_state->player, delta_time);
-            
-            // Sync AI health with enemy health
-            enemy->health = enemy->ai->health;
-            
-            // Update legacy ai_state for compatibility
-            switch (enemy->ai->state) {
-                case AI_STATE_IDLE: enemy->ai_state = AI_PATROL; break;
-                case AI_STATE_CHASING: enemy->ai_state = AI_CHASE; break;
-                case AI_STATE_ATTACKING: enemy->ai_state = AI_ATTACK; break;
-                case AI_STATE_DEAD: enemy->ai_state = AI_DEAD; break;
+            if (enemy->ai->pending_attack) {
+                enemy->ai->pending_attack = 0;
+                attack_player(enemy, &game_state->player);
             }
         } else {
             // Fallback to old AI system
@@ -120,6 +307,7 @@ void update_enemies(float delta_time) {
             update_enemy_movement(enemy, delta_time);
         }
     }
+    TRACE_END();
 }
 
 void update_enemy_ai(Enemy* enemy, PlayerState* player, float delta_time) {
@@ -138,8 +326,8 @@ void update_enemy_ai(Enemy* enemy, PlayerState* player, float delta_time) {
             // Switch to chase if player is close
             if (distance_to_player < 12.0f) {
                 enemy->ai_state = AI_CHASE;
-                printf("Enemy %p started chasing player (distance: %.2f)\n", 
-                       (void*)enemy, distance_to_player);
+                LOG_DEBUG(LOG_CATEGORY_AI, "Enemy %p started chasing player (distance: %.2f)", 
+                          (void*)enemy, distance_to_player);
             }
             break;
             
@@ -148,13 +336,13 @@ void update_enemy_ai(Enemy* enemy, PlayerState* player, float delta_time) {
             if (distance_to_player <= enemy->attack_range) {
                 enemy->ai_state = AI_ATTACK;
                 enemy->last_attack_time = 0.0f;
-                printf("Enemy %p entered attack range (distance: %.2f)\n", 
-                       (void*)enemy, distance_to_player);
+                LOG_DEBUG(LOG_CATEGORY_AI, "Enemy %p entered attack range (distance: %.2f)", 
+                          (void*)enemy, distance_to_player);
             }
             // Return to patrol if player is too far
             else if (distance_to_player > 15.0f) {
                 enemy->ai_state = AI_PATROL;
-                printf("Enemy %p lost player, returning to patrol\n", (void*)enemy);
+                LOG_DEBUG(LOG_CATEGORY_AI, "Enemy %p lost player, returning to patrol", (void*)enemy);
             }
             break;
             
@@ -170,7 +358,7 @@ void update_enemy_ai(Enemy* enemy, PlayerState* player, float delta_time) {
             // Return to chase if player moves away
             if (distance_to_player > enemy->attack_range + 1.0f) {
                 enemy->ai_state = AI_CHASE;
-                printf("Enemy %p player moved away, chasing again\n", (void*)enemy);
+                LOG_DEBUG(LOG_CATEGORY_AI, "Enemy %p player moved away, chasing again", (void*)enemy);
             }
             break;
             
@@ -209,8 +397,6 @@ void update_enemy_movement(Enemy* enemy, float delta_time) {
 }
 
 void attack_player(Enemy* enemy, PlayerState* player) {
-    printf("Enemy %p attacks player! ", (void*)enemy);
-    
     // Create projectile towards player
     Vector3 direction;
     direction.x = player->position.x - enemy->position.x;
@@ -242,52 +428,67 @@ void attack_player(Enemy* enemy, PlayerState* player) {
         Vector3 spawn_pos = enemy->position;
         spawn_pos.y += 1.0f; // Spawn slightly above enemy
         
-        create_projectile(PROJECTILE_ENEMY_BULLET, spawn_pos, projectile_velocity, -1);
+        create_projectile(PROJECTILE_ENEMY_BULLET, spawn_pos, projectile_velocity, get_enemy_handle(enemy));
         
-        // Play enemy shoot sound
-        play_enemy_shoot_sound(enemy->position);
+        // Play enemy shoot sound, once even if a rollback runs the tick again
+        if (!rollback_is_resimulating()) {
+            play_enemy_shoot_sound(enemy->position);
+        }
         
-        printf("Enemy fired projectile at player!\n");
+        LOG_DEBUG(LOG_CATEGORY_AI, "Enemy %p fired projectile at player", (void*)enemy);
     }
 }
 
 void remove_enemy(int enemy_id) {
     GameState* game_state = get_game_state();
     
-    if (enemy_id < 0 || enemy_id >= game_state->enemy_count) {
+    if (!entity_pool_is_valid(&game_state->enemy_pool, enemy_id)) {
         return;
     }
     
-    printf("Removing enemy ID: %d\n", enemy_id);
+    LOG_DEBUG(LOG_CATEGORY_GAMEPLAY, "Removing enemy ID: %d", enemy_id);
     
-    // Free AI memory if allocated
-    if (game_state->enemies[enemy_id].ai) {
-        free(game_state->enemies[enemy_id].ai);
-        game_state->enemies[enemy_id].ai = NULL;
-    }
+    Enemy* enemy = &game_state->enemies[entity_handle_slot(enemy_id)];
+    
+    // The AI component stays in its slot and is reinitialized on the next spawn
+    enemy->ai = NULL;
+    enemy->is_active = 0;
     
-    // Shift remaining enemies down
-    for (int i = enemy_id; i < game_state->enemy_count - 1; i++) {
-        game_state->enemies[i] = game_state->enemies[i + 1];
+    entity_pool_release(&game_state->enemy_pool, enemy_id);
+    game_state->enemy_count = game_state->enemy_pool.count;
+}
+
+Enemy* get_enemy(int enemy_id) {
+    GameState* game_state = get_game_state();
+    
+    if (!entity_pool_is_valid(&game_state->enemy_pool, enemy_id)) {
+        return NULL;
     }
+    return &game_state->enemies[entity_handle_slot(enemy_id)];
+}
+
+int get_enemy_handle(const Enemy* enemy) {
+    GameState* game_state = get_game_state();
     
-    game_state->enemy_count--;
+    int slot = (int)(enemy - game_state->enemies);
+    return entity_pool_handle_for_slot(&game_state->enemy_pool, slot);
 }
 
 // Projectile management functions
 int create_projectile(ProjectileType type, Vector3 position, Vector3 velocity, int owner_id) {
     GameState* game_state = get_game_state();
     
-    if (game_state->projectile_count >= MAX_PROJECTILES) {
-        printf("Cannot create projectile: maximum limit reached (%d)\n", MAX_PROJECTILES);
-        return -1;
+    int projectile_id = entity_pool_acquire(&game_state->projectile_pool);
+    if (projectile_id == INVALID_ENTITY_HANDLE) {
+        LOG_WARN(LOG_CATEGORY_GAMEPLAY, "Cannot create projectile: maximum limit reached (%d)", game_state->projectile_pool.capacity);
+        return INVALID_ENTITY_HANDLE;
     }
     
-    int projectile_id = game_state->projectile_count;
-    Projectile* projectile = &game_state->projectiles[projectile_id];
+    Projectile* projectile = &game_state->projectiles[entity_handle_slot(projectile_id)];
     
     // Initialize projectile
     projectile->position = position;
+    projectile->previous_position = position;
     projectile->velocity = velocity;
     projectile->type = type;
     projectile->owner_id = owner_id;
@@ -303,85 +504,126 @@ int create_projectile(ProjectileType type, Vector3 position, Vector3 velocity, i
             break;
     }
     
-    game_state->projectile_count++;
+    projectile_soa_push(&g_projectile_soa, projectile);
+    game_state->projectile_count = game_state->projectile_pool.count;
     
-    printf("Created %s projectile at (%.2f, %.2f, %.2f) - ID: %d\n",
-           type == PROJECTILE_PLAYER_BULLET ? "PLAYER" : "ENEMY",
-           position.x, position.y, position.z, projectile_id);
+    LOG_DEBUG(LOG_CATEGORY_GAMEPLAY, "Created %s projectile at (%.2f, %.2f, %.2f) - ID: %d",
+              type == PROJECTILE_PLAYER_BULLET ? "PLAYER" : "ENEMY",
+              position.x, position.y, position.z, projectile_id);
     
     return projectile_id;
 }
 
-void update_projectiles(float delta_time) {
+void rebuild_enemy_spatial_hash() {
     GameState* game_state = get_game_state();
+    EntityPool* enemy_pool = &game_state->enemy_pool;
     
-    for (int i = game_state->projectile_count - 1; i >= 0; i--) {
-        Projectile* projectile = &game_state->projectiles[i];
+    spatial_hash_clear(&g_enemy_hash);
+    for (int i = 0; i < enemy_pool->count; i++) {
+        int slot = enemy_pool->alive[i];
+        Enemy* enemy = &game_state->enemies[slot];
+        if (enemy->ai_state == AI_DEAD || !enemy->is_active) continue;
         
-        // Update position
-        projectile->position.x += projectile->velocity.x * delta_time;
-        projectile->position.y += projectile->velocity.y * delta_time;
-        projectile->position.z += projectile->velocity.z * delta_time;
-        
-        // Apply gravity (reduced for faster projectiles)
-        projectile->velocity.y -= 5.0f * delta_time;
-        
-        // Update lifetime
-        projectile->lifetime -= delta_time;
+        CollisionVolume volume = get_enemy_collision_volume(enemy);
+        spatial_hash_insert(&g_enemy_hash, slot, volume.center, volume.radius);
+    }
+}
+
+const SpatialHash* get_enemy_spatial_hash() {
+    return &g_enemy_hash;
+}
+
+void update_projectiles(float delta_time) {
+    GameState* game_state = get_game_state();
+    EntityPool* pool = &game_state->projectile_pool;
+    
+    // Bucket live enemies once so each bullet only tests its neighbourhood
+    TRACE_BEGIN("enemy_hash_rebuild");
+    rebuild_enemy_spatial_hash();
+    TRACE_END();
+    
+    // Integrate, apply gravity and decay lifetimes for all projectiles at once
+    TRACE_BEGIN("projectile_integrate");
+    projectile_soa_integrate(&g_projectile_soa, delta_time, PROJECTILE_GRAVITY);
+    TRACE_END();
+    
+    TRACE_BEGIN("projectile_collisions");
+    // Walk the alive list backwards so removals only move already-visited entries
+    for (int i = pool->count - 1; i >= 0; i--) {
+        int slot = pool->alive[i];
+        Projectile* projectile = &game_state->projectiles[slot];
         
-        // Check for removal conditions
-        int should_remove = 0;
+        // Refresh the AoS view used by collision checks and the public API
+        projectile_soa_store(&g_projectile_soa, i, projectile);
         
-        // Remove if lifetime expired
-        if (projectile->lifetime <= 0.0f) {
-            should_remove = 1;
-        }
+        // Remove if lifetime expired or hit ground
+        int should_remove = g_projectile_soa.flags[i] != 0;
         
-        // Remove if hit ground
-        if (projectile->position.y <= 0.0f) {
-            should_remove = 1;
-        }
+        // Sweep the whole step so fast bullets cannot tunnel through enemies
+        Vector3 previous_position = projectile_soa_previous_position(&g_projectile_soa, i);
         
         // Check collisions with enemies (for player bullets)
         if (projectile->type == PROJECTILE_PLAYER_BULLET) {
-            for (int j = 0; j < game_state->enemy_count; j++) {
-                Enemy* enemy = &game_state->enemies[j];
+            // Broadphase query with a sphere bounding the swept segment
+            CollisionVolume proj_vol = get_projectile_collision_volume(projectile);
+            Vector3 segment_center = {
+                (previous_position.x + proj_vol.center.x) * 0.5f,
+                (previous_position.y + proj_vol.center.y) * 0.5f,
+                (previous_position.z + proj_vol.center.z) * 0.5f
+            };
+            float segment_radius = vector3_distance(previous_position, proj_vol.center) * 0.5f + proj_vol.radius;
+            
+            int* candidates = g_broadphase_candidates;
+            int candidate_count = spatial_hash_query_sphere(&g_enemy_hash, segment_center, segment_radius,
+                                                            candidates, g_enemy_hash.capacity);
+            
+            // The bullet stops at the first enemy along its path
+            Enemy* hit_enemy = NULL;
+            CollisionResult collision = {0};
+            for (int j = 0; j < candidate_count; j++) {
+                Enemy* enemy = &game_state->enemies[candidates[j]];
+                // Enemies killed earlier this pass are still in the hash
                 if (enemy->ai_state == AI_DEAD || !enemy->is_active) continue;
                 
-                CollisionResult collision;
-                if (check_projectile_enemy_collision(projectile, enemy, &collision)) {
-                    // Create damage info
-                    DamageInfo damage;
-                    damage.amount = projectile->damage;
-                    damage.hit_point = collision.hit_point;
-                    damage.hit_direction = vector3_normalize(projectile->velocity);
-                    damage.damage_type = 0; // bullet damage
-                    
-                    // Apply damage using new system
-                    apply_damage_to_enemy(enemy, &damage);
-                    
-                    // Award points if enemy was killed
-                    if (enemy->ai_state == AI_DEAD) {
-                        int points = 0;
-                        switch (enemy->type) {
-                            case ENEMY_BASIC: points = 100; break;
-                            case ENEMY_FAST: points = 150; break;
-                            case ENEMY_HEAVY: points = 200; break;
-                        }
-                        game_state->score += points;
-                        printf("Enemy killed! +%d points, Score: %d\n", points, game_state->score);
+                CollisionResult candidate;
+                if (check_projectile_enemy_swept(projectile, previous_position, enemy, &candidate) &&
+                    (!hit_enemy || candidate.time_of_impact < collision.time_of_impact)) {
+                    hit_enemy = enemy;
+                    collision = candidate;
+                }
+            }
+            
+            if (hit_enemy) {
+                // Create damage info
+                DamageInfo damage;
+                damage.amount = projectile->damage;
+                damage.hit_point = collision.hit_point;
+                damage.hit_direction = vector3_normalize(projectile->velocity);
+                damage.damage_type = 0; // bullet damage
+                
+                // Apply damage using new system
+                apply_damage_to_enemy(hit_enemy, &damage);
+                
+                // Award points if enemy was killed
+                if (hit_enemy->ai_state == AI_DEAD) {
+                    int points = 0;
+                    switch (hit_enemy->type) {
+                        case ENEMY_BASIC: points = 100; break;
+                        case ENEMY_FAST: points = 150; break;
+                        case ENEMY_HEAVY: points = 200; break;
                     }
-                    
-                    should_remove = 1;
-                    break;
+                    game_state->score += points;
+                    LOG_INFO(LOG_CATEGORY_GAMEPLAY, "Enemy killed! +%d points, Score: %d", points, game_state->score);
                 }
+                
+                should_remove = 1;
             }
         }
         
         // Check collision with player (for enemy bullets)
         if (projectile->type == PROJECTILE_ENEMY_BULLET) {
             CollisionResult collision;
-            if (check_projectile_player_collision(projectile, &game_state->player, &collision)) {
+            if (check_projectile_player_swept(projectile, previous_position, &game_state->player, &collision)) {
                 // Create damage info
                 DamageInfo damage;
                 damage.amount = projectile->damage;
@@ -393,7 +635,7 @@ void update_projectiles(float delta_time) {
                 apply_damage_to_player(&game_state->player, &damage);
                 
                 if (game_state->player.health <= 0) {
-                    printf("Player died! Game Over!\n");
+                    LOG_INFO(LOG_CATEGORY_GAMEPLAY, "Player died! Game Over!");
                     game_state->current_phase = GAME_OVER;
                 }
                 
@@ -402,50 +644,57 @@ void update_projectiles(float delta_time) {
         }
         
         if (should_remove) {
-            remove_projectile(i);
+            remove_projectile(entity_pool_handle_for_slot(pool, slot));
         }
     }
+    TRACE_END();
 }
 
 void remove_projectile(int projectile_id) {
     GameState* game_state = get_game_state();
     
-    if (projectile_id < 0 || projectile_id >= game_state->projectile_count) {
+    if (!entity_pool_is_valid(&game_state->projectile_pool, projectile_id)) {
         return;
     }
     
-    // Shift remaining projectiles down
-    for (int i = projectile_id; i < game_state->projectile_count - 1; i++) {
-        game_state->projectiles[i] = game_state->projectiles[i + 1];
+    // The SoA entry moves exactly like the pool's alive list entry
+    int index = game_state->projectile_pool.alive_index[entity_handle_slot(projectile_id)];
+    if (entity_pool_release(&game_state->projectile_pool, projectile_id)) {
+        projectile_soa_remove(&g_projectile_soa, index);
+        game_state->projectile_count = game_state->projectile_pool.count;
     }
+}
+
+Projectile* get_projectile(int projectile_id) {
+    GameState* game_state = get_game_state();
     
-    game_state->projectile_count--;
+    if (!entity_pool_is_valid(&game_state->projectile_pool, projectile_id)) {
+        return NULL;
+    }
+    return &game_state->projectiles[entity_handle_slot(projectile_id)];
 }
 
 // Spawning functions
 void spawn_enemy_wave(int count) {
-    printf("Spawning enemy wave: %d enemies\n", count);
+    LOG_INFO(LOG_CATEGORY_GAMEPLAY, "Spawning enemy wave: %d enemies", count);
     
     for (int i = 0; i < count; i++) {
         // Choose random spawn point
-        int spawn_index = rand() % num_spawn_points;
+        int spawn_index = random_int(RNG_STREAM_GAMEPLAY, num_spawn_points);
         Vector3 spawn_pos = enemy_spawn_points[spawn_index];
         
         // Add some randomness to spawn position
-        spawn_pos.x += ((float)rand() / RAND_MAX - 0.5f) * 4.0f;
-        spawn_pos.z += ((float)rand() / RAND_MAX - 0.5f) * 4.0f;
+        spawn_pos.x += random_range(RNG_STREAM_GAMEPLAY, -2.0f, 2.0f);
+        spawn_pos.z += random_range(RNG_STREAM_GAMEPLAY, -2.0f, 2.0f);
         
         // Choose random enemy type
-        EnemyType type = (EnemyType)(rand() % 3);
+        EnemyType type = (EnemyType)random_int(RNG_STREAM_GAMEPLAY, 3);
         
         create_enemy(type, spawn_pos);
     }
 }
 
 void spawn_enemies_periodically(float delta_time) {
-    static float spawn_timer = 0.0f;
-    static float spawn_interval = 10.0f; // Spawn every 10 seconds
-    
     GameState* game_state = get_game_state();
     
     // Only spawn in playing mode
@@ -453,21 +702,21 @@ void spawn_enemies_periodically(float delta_time) {
         return;
     }
     
-    spawn_timer += delta_time;
+    g_spawn_timer += delta_time;
     
-    if (spawn_timer >= spawn_interval) {
+    if (g_spawn_timer >= g_spawn_interval) {
         // Don't spawn if too many enemies already
-        if (game_state->enemy_count < MAX_ENEMIES / 2) {
-            int enemies_to_spawn = 1 + (rand() % 3); // 1-3 enemies
+        if (game_state->enemy_count < game_state->max_enemies / 2) {
+            int enemies_to_spawn = 1 + random_int(RNG_STREAM_GAMEPLAY, 3); // 1-3 enemies
             spawn_enemy_wave(enemies_to_spawn);
         }
         
-        spawn_timer = 0.0f;
+        g_spawn_timer = 0.0f;
         
         // Gradually decrease spawn interval (increase difficulty)
-        if (spawn_interval > 5.0f) {
-            spawn_interval -= 0.5f;
-            printf("Spawn interval decreased to %.1f seconds\n", spawn_interval);
+        if (g_spawn_interval > MIN_SPAWN_INTERVAL) {
+            g_spawn_interval -= 0.5f;
+            LOG_INFO(LOG_CATEGORY_GAMEPLAY, "Spawn interval decreased to %.1f seconds", g_spawn_interval);
         }
     }
 }
@@ -482,6 +731,49 @@ int get_projectile_count() {
     return game_state->projectile_count;
 }
 
+EnemyAI* get_enemy_ai_components() {
+    return g_enemy_ai;
+}
+
+void save_object_manager_snapshot(ObjectManagerSnapshot* snapshot) {
+    snapshot->ai_tick = g_ai_tick;
+    snapshot->ai_cursor = g_ai_cursor;
+    snapshot->spawn_timer = g_spawn_timer;
+    snapshot->spawn_interval = g_spawn_interval;
+    save_flow_field_snapshot(&snapshot->flow_field);
+}
+
+void load_object_manager_snapshot(const ObjectManagerSnapshot* snapshot) {
+    GameState* game_state = get_game_state();
+    g_ai_tick = snapshot->ai_tick;
+    g_ai_cursor = snapshot->ai_cursor;
+    g_spawn_timer = snapshot->spawn_timer;
+    g_spawn_interval = snapshot->spawn_interval;
+    load_flow_field_snapshot(&snapshot->flow_field);
+    
+    // Enemies point at the AI component in their own slot
+    for (int i = 0; i < game_state->max_enemies; i++) {
+        Enemy* enemy = &game_state->enemies[i];
+        enemy->ai = (enemy->ai && g_enemy_ai) ? &g_enemy_ai[i] : NULL;
+    }
+    
+    // The projectile SoA follows the restored alive list
+    projectile_soa_clear(&g_projectile_soa);
+    EntityPool* projectile_pool = &game_state->projectile_pool;
+    for (int i = 0; i < projectile_pool->count; i++) {
+        projectile_soa_push(&g_projectile_soa, &game_state->projectiles[projectile_pool->alive[i]]);
+    }
+    
+    rebuild_enemy_spatial_hash();
+}
+
 void cleanup_object_manager() {
+    // Storage belongs to the level arena, released with the game state
+    memset(&g_projectile_soa, 0, sizeof(ProjectileSoA));
+    memset(&g_enemy_hash, 0, sizeof(SpatialHash));
+    g_enemy_ai = NULL;
+    g_ai_batch = NULL;
+    g_broadphase_candidates = NULL;
+    cleanup_flow_field();
     printf("Object Manager cleaned up\n");
 }
\ No newline at end of file
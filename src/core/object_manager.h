@@ -2,23 +2,53 @@
 #define OBJECT_MANAGER_H
 
 #include "game_api.h"
+#include "collision_system.h"
+#include "flow_field.h"
+#include <stddef.h>
 
-// Object Manager initialization
+// Scheduling and spawn state kept outside GameState, saved with game snapshots
+typedef struct {
+    unsigned int ai_tick;
+    int ai_cursor;
+    float spawn_timer;
+    float spawn_interval;
+    FlowFieldSnapshot flow_field;
+} ObjectManagerSnapshot;
+
+// Object Manager initialization - storage comes from the level arena, which
+// needs object_manager_storage_size() bytes on top of the entity arrays
+size_t object_manager_storage_size(int max_enemies, int max_projectiles);
 void init_object_manager();
 void cleanup_object_manager();
 
 // Enemy management functions
+// Enemy and projectile IDs are generational handles from the entity pools;
+// they stay valid until the object is removed and are never reused for
+// a different object
 int create_enemy(EnemyType type, Vector3 position);
 void update_enemies(float delta_time);
+// Per-tick wall-clock budget for mid and far range enemy AI updates
+void set_ai_time_budget(double seconds);
+// Serve every due update regardless of the budget, so which enemies think on
+// a tick never depends on timing (recording and replaying input)
+void set_deterministic_ai(int enabled);
 void update_enemy_ai(Enemy* enemy, PlayerState* player, float delta_time);
 void update_enemy_movement(Enemy* enemy, float delta_time);
 void attack_player(Enemy* enemy, PlayerState* player);
 void remove_enemy(int enemy_id);
+Enemy* get_enemy(int enemy_id);
+int get_enemy_handle(const Enemy* enemy);
 
 // Projectile management functions
 int create_projectile(ProjectileType type, Vector3 position, Vector3 velocity, int owner_id);
 void update_projectiles(float delta_time);
 void remove_projectile(int projectile_id);
+Projectile* get_projectile(int projectile_id);
+
+// Enemy broadphase, ids are enemy slots. Rebuilt at the start of
+// update_projectiles(); call rebuild_enemy_spatial_hash() for fresher data
+void rebuild_enemy_spatial_hash();
+const SpatialHash* get_enemy_spatial_hash();
 
 // Spawning functions
 void spawn_enemy_wave(int count);
@@ -28,4 +58,12 @@ void spawn_enemies_periodically(float delta_time);
 int get_enemy_count();
 int get_projectile_count();
 
+// AI components, one per enemy slot (max_enemies entries)
+struct EnemyAI* get_enemy_ai_components();
+
+// Restore after the enemies, AI components and pools were overwritten: also
+// relinks AI pointers and rebuilds the projectile SoA and enemy broadphase
+void save_object_manager_snapshot(ObjectManagerSnapshot* snapshot);
+void load_object_manager_snapshot(const ObjectManagerSnapshot* snapshot);
+
 #endif // OBJECT_MANAGER_H
\ No newline at end of file
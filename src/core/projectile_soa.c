@@ -0,0 +1,204 @@
+#include "projectile_soa.h"
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define PROJECTILE_SOA_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PROJECTILE_SOA_SSE 1
+#endif
+
+// Arrays are aligned for the widest vector width in use
+#define PROJECTILE_SOA_ALIGNMENT 32
+
+// Ten float arrays and the flags, each padded up to the alignment
+size_t projectile_soa_storage_size(int capacity) {
+    return (size_t)capacity * (10 * sizeof(float) + sizeof(unsigned int)) + 11 * PROJECTILE_SOA_ALIGNMENT;
+}
+
+int projectile_soa_init(ProjectileSoA* soa, int capacity, Arena* arena) {
+    memset(soa, 0, sizeof(ProjectileSoA));
+    if (capacity <= 0) {
+        return 0;
+    }
+    
+    size_t float_bytes = (size_t)capacity * sizeof(float);
+    float** arrays[] = {
+        &soa->pos_x, &soa->pos_y, &soa->pos_z,
+        &soa->prev_x, &soa->prev_y, &soa->prev_z,
+        &soa->vel_x, &soa->vel_y, &soa->vel_z,
+        &soa->lifetime
+    };
+    
+    for (size_t i = 0; i < sizeof(arrays) / sizeof(arrays[0]); i++) {
+        *arrays[i] = (float*)arena_alloc_zeroed(arena, float_bytes, PROJECTILE_SOA_ALIGNMENT);
+        if (!*arrays[i]) {
+            printf("Failed to allocate projectile SoA for %d projectiles\n", capacity);
+            memset(soa, 0, sizeof(ProjectileSoA));
+            return 0;
+        }
+    }
+    
+    soa->flags = (unsigned int*)arena_alloc_zeroed(arena, (size_t)capacity * sizeof(unsigned int),
+                                                   PROJECTILE_SOA_ALIGNMENT);
+    if (!soa->flags) {
+        printf("Failed to allocate projectile SoA for %d projectiles\n", capacity);
+        memset(soa, 0, sizeof(ProjectileSoA));
+        return 0;
+    }
+    
+    soa->capacity = capacity;
+    return 1;
+}
+
+void projectile_soa_clear(ProjectileSoA* soa) {
+    soa->count = 0;
+}
+
+void projectile_soa_push(ProjectileSoA* soa, const Projectile* projectile) {
+    if (soa->count >= soa->capacity) {
+        return;
+    }
+    
+    int i = soa->count++;
+    soa->pos_x[i] = projectile->position.x;
+    soa->pos_y[i] = projectile->position.y;
+    soa->pos_z[i] = projectile->position.z;
+    soa->prev_x[i] = projectile->position.x;
+    soa->prev_y[i] = projectile->position.y;
+    soa->prev_z[i] = projectile->position.z;
+    soa->vel_x[i] = projectile->velocity.x;
+    soa->vel_y[i] = projectile->velocity.y;
+    soa->vel_z[i] = projectile->velocity.z;
+    soa->lifetime[i] = projectile->lifetime;
+    soa->flags[i] = 0;
+}
+
+void projectile_soa_remove(ProjectileSoA* soa, int index) {
+    if (index < 0 || index >= soa->count) {
+        return;
+    }
+    
+    // Same swap-with-last as the pool's alive list
+    int last = --soa->count;
+    soa->pos_x[index] = soa->pos_x[last];
+    soa->pos_y[index] = soa->pos_y[last];
+    soa->pos_z[index] = soa->pos_z[last];
+    soa->prev_x[index] = soa->prev_x[last];
+    soa->prev_y[index] = soa->prev_y[last];
+    soa->prev_z[index] = soa->prev_z[last];
+    soa->vel_x[index] = soa->vel_x[last];
+    soa->vel_y[index] = soa->vel_y[last];
+    soa->vel_z[index] = soa->vel_z[last];
+    soa->lifetime[index] = soa->lifetime[last];
+    soa->flags[index] = soa->flags[last];
+}
+
+static void integrate_scalar(ProjectileSoA* soa, int begin, int end, float delta_time, float gravity) {
+    for (int i = begin; i < end; i++) {
+        soa->prev_x[i] = soa->pos_x[i];
+        soa->prev_y[i] = soa->pos_y[i];
+        soa->prev_z[i] = soa->pos_z[i];
+        soa->pos_x[i] += soa->vel_x[i] * delta_time;
+        soa->pos_y[i] += soa->vel_y[i] * delta_time;
+        soa->pos_z[i] += soa->vel_z[i] * delta_time;
+        soa->vel_y[i] -= gravity * delta_time;
+        soa->lifetime[i] -= delta_time;
+        
+        unsigned int flags = 0;
+        if (soa->lifetime[i] <= 0.0f) flags |= PROJECTILE_FLAG_EXPIRED;
+        if (soa->pos_y[i] <= 0.0f) flags |= PROJECTILE_FLAG_GROUNDED;
+        soa->flags[i] = flags;
+    }
+}
+
+void projectile_soa_integrate(ProjectileSoA* soa, float delta_time, float gravity) {
+    int i = 0;
+    int count = soa->count;
+
+#if defined(PROJECTILE_SOA_AVX)
+    __m256 dt = _mm256_set1_ps(delta_time);
+    __m256 dv = _mm256_set1_ps(gravity * delta_time);
+    __m256 zero = _mm256_setzero_ps();
+    __m256 expired_bit = _mm256_castsi256_ps(_mm256_set1_epi32((int)PROJECTILE_FLAG_EXPIRED));
+    __m256 grounded_bit = _mm256_castsi256_ps(_mm256_set1_epi32((int)PROJECTILE_FLAG_GROUNDED));
+    
+    for (; i + 8 <= count; i += 8) {
+        __m256 vx = _mm256_load_ps(soa->vel_x + i);
+        __m256 vy = _mm256_load_ps(soa->vel_y + i);
+        __m256 vz = _mm256_load_ps(soa->vel_z + i);
+        
+        __m256 ox = _mm256_load_ps(soa->pos_x + i);
+        __m256 oy = _mm256_load_ps(soa->pos_y + i);
+        __m256 oz = _mm256_load_ps(soa->pos_z + i);
+        _mm256_store_ps(soa->prev_x + i, ox);
+        _mm256_store_ps(soa->prev_y + i, oy);
+        _mm256_store_ps(soa->prev_z + i, oz);
+        
+        __m256 px = _mm256_add_ps(ox, _mm256_mul_ps(vx, dt));
+        __m256 py = _mm256_add_ps(oy, _mm256_mul_ps(vy, dt));
+        __m256 pz = _mm256_add_ps(oz, _mm256_mul_ps(vz, dt));
+        __m256 life = _mm256_sub_ps(_mm256_load_ps(soa->lifetime + i), dt);
+        
+        _mm256_store_ps(soa->pos_x + i, px);
+        _mm256_store_ps(soa->pos_y + i, py);
+        _mm256_store_ps(soa->pos_z + i, pz);
+        _mm256_store_ps(soa->vel_y + i, _mm256_sub_ps(vy, dv));
+        _mm256_store_ps(soa->lifetime + i, life);
+        
+        // Comparison masks are all ones per lane, so AND picks out the flag bit
+        __m256 expired = _mm256_and_ps(_mm256_cmp_ps(life, zero, _CMP_LE_OQ), expired_bit);
+        __m256 grounded = _mm256_and_ps(_mm256_cmp_ps(py, zero, _CMP_LE_OQ), grounded_bit);
+        _mm256_store_si256((__m256i*)(soa->flags + i), _mm256_castps_si256(_mm256_or_ps(expired, grounded)));
+    }
+#elif defined(PROJECTILE_SOA_SSE)
+    __m128 dt = _mm_set1_ps(delta_time);
+    __m128 dv = _mm_set1_ps(gravity * delta_time);
+    __m128 zero = _mm_setzero_ps();
+    __m128i expired_bit = _mm_set1_epi32((int)PROJECTILE_FLAG_EXPIRED);
+    __m128i grounded_bit = _mm_set1_epi32((int)PROJECTILE_FLAG_GROUNDED);
+    
+    for (; i + 4 <= count; i += 4) {
+        __m128 vx = _mm_load_ps(soa->vel_x + i);
+        __m128 vy = _mm_load_ps(soa->vel_y + i);
+        __m128 vz = _mm_load_ps(soa->vel_z + i);
+        
+        __m128 ox = _mm_load_ps(soa->pos_x + i);
+        __m128 oy = _mm_load_ps(soa->pos_y + i);
+        __m128 oz = _mm_load_ps(soa->pos_z + i);
+        _mm_store_ps(soa->prev_x + i, ox);
+        _mm_store_ps(soa->prev_y + i, oy);
+        _mm_store_ps(soa->prev_z + i, oz);
+        
+        __m128 px = _mm_add_ps(ox, _mm_mul_ps(vx, dt));
+        __m128 py = _mm_add_ps(oy, _mm_mul_ps(vy, dt));
+        __m128 pz = _mm_add_ps(oz, _mm_mul_ps(vz, dt));
+        __m128 life = _mm_sub_ps(_mm_load_ps(soa->lifetime + i), dt);
+        
+        _mm_store_ps(soa->pos_x + i, px);
+        _mm_store_ps(soa->pos_y + i, py);
+        _mm_store_ps(soa->pos_z + i, pz);
+        _mm_store_ps(soa->vel_y + i, _mm_sub_ps(vy, dv));
+        _mm_store_ps(soa->lifetime + i, life);
+        
+        __m128i expired = _mm_and_si128(_mm_castps_si128(_mm_cmple_ps(life, zero)), expired_bit);
+        __m128i grounded = _mm_and_si128(_mm_castps_si128(_mm_cmple_ps(py, zero)), grounded_bit);
+        _mm_store_si128((__m128i*)(soa->flags + i), _mm_or_si128(expired, grounded));
+    }
+#endif
+
+    // Remainder, or everything when no vector unit is available
+    integrate_scalar(soa, i, count, delta_time, gravity);
+}
+
+void projectile_soa_store(const ProjectileSoA* soa, int index, Projectile* projectile) {
+    projectile->position.x = soa->pos_x[index];
+    projectile->position.y = soa->pos_y[index];
+    projectile->position.z = soa->pos_z[index];
+    projectile->velocity.x = soa->vel_x[index];
+    projectile->velocity.y = soa->vel_y[index];
+    projectile->velocity.z = soa->vel_z[index];
+    projectile->lifetime = soa->lifetime[index];
+}
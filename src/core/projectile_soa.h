@@ -0,0 +1,52 @@
+#ifndef PROJECTILE_SOA_H
+#define PROJECTILE_SOA_H
+
+#include "game_api.h"
+#include "arena.h"
+
+// Flags produced by the integration kernel
+#define PROJECTILE_FLAG_EXPIRED  0x1u
+#define PROJECTILE_FLAG_GROUNDED 0x2u
+
+// Hot projectile fields split into parallel arrays. Index i holds the
+// projectile in slot projectile_pool.alive[i], so the arrays stay dense and
+// are swap-removed in step with the pool's alive list.
+typedef struct {
+    int capacity;
+    int count;
+    float* pos_x;
+    float* pos_y;
+    float* pos_z;
+    float* prev_x;      // Position before the last integration step
+    float* prev_y;
+    float* prev_z;
+    float* vel_x;
+    float* vel_y;
+    float* vel_z;
+    float* lifetime;
+    unsigned int* flags;
+} ProjectileSoA;
+
+// Setup - arrays are carved from the given arena, which needs
+// projectile_soa_storage_size() bytes for them
+size_t projectile_soa_storage_size(int capacity);
+int projectile_soa_init(ProjectileSoA* soa, int capacity, Arena* arena);
+void projectile_soa_clear(ProjectileSoA* soa);
+
+// Dense list maintenance, mirrors entity_pool_acquire/entity_pool_release
+void projectile_soa_push(ProjectileSoA* soa, const Projectile* projectile);
+void projectile_soa_remove(ProjectileSoA* soa, int index);
+
+// Save the previous position, integrate, apply gravity, decay lifetime and
+// flag projectiles that expired or reached the ground. Uses AVX or SSE when
+// available.
+void projectile_soa_integrate(ProjectileSoA* soa, float delta_time, float gravity);
+
+// Copy the hot fields of one entry back into its AoS Projectile
+void projectile_soa_store(const ProjectileSoA* soa, int index, Projectile* projectile);
+
+static inline Vector3 projectile_soa_previous_position(const ProjectileSoA* soa, int index) {
+    return (Vector3){soa->prev_x[index], soa->prev_y[index], soa->prev_z[index]};
+}
+
+#endif // PROJECTILE_SOA_H
@@ -0,0 +1,304 @@
+#include "replay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REPLAY_INITIAL_EVENTS 1024
+
+typedef struct {
+    unsigned long tick;
+    ReplayEvent event;
+} ReplayEntry;
+
+typedef struct {
+    // Recording
+    FILE* file;
+    unsigned long last_tick;
+    unsigned long event_count;
+    
+    // Playback
+    ReplayHeader header;
+    ReplayEntry* entries;
+    int entry_count;
+    int cursor;
+    unsigned long end_tick;
+    unsigned int checksum;
+    int playing;
+} ReplayState;
+
+static ReplayState g_replay;
+
+static void write_varint(FILE* file, unsigned long value) {
+    while (value >= 0x80) {
+        fputc((int)(value & 0x7F) | 0x80, file);
+        value >>= 7;
+    }
+    fputc((int)value, file);
+}
+
+static int read_varint(const unsigned char** cursor, const unsigned char* end, unsigned long* value) {
+    unsigned long result = 0;
+    int shift = 0;
+    while (*cursor < end && shift < 64) {
+        unsigned char byte = *(*cursor)++;
+        result |= (unsigned long)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return 1;
+        }
+        shift += 7;
+    }
+    return 0;
+}
+
+int replay_record_start(const char* path, const ReplayHeader* header) {
+    if (g_replay.file) {
+        return 0;
+    }
+    
+    g_replay.file = fopen(path, "wb");
+    if (!g_replay.file) {
+        printf("Replay: cannot open %s for writing\n", path);
+        return 0;
+    }
+    
+    fwrite(header, sizeof(ReplayHeader), 1, g_replay.file);
+    g_replay.last_tick = 0;
+    g_replay.event_count = 0;
+    printf("Replay: recording to %s (seed %u)\n", path, header->seed);
+    return 1;
+}
+
+void replay_record_event(unsigned long tick, const ReplayEvent* event) {
+    FILE* file = g_replay.file;
+    if (!file || event->type < 0 || event->type >= REPLAY_EVENT_END) {
+        return;
+    }
+    
+    fputc(event->type, file);
+    write_varint(file, tick - g_replay.last_tick);
+    g_replay.last_tick = tick;
+    
+    switch (event->type) {
+        case REPLAY_EVENT_KEY:
+            write_varint(file, (unsigned long)event->code);
+            fputc(event->action ? 1 : 0, file);
+            break;
+            
+        case REPLAY_EVENT_MOUSE_MOVE:
+            fwrite(&event->x, sizeof(float), 1, file);
+            fwrite(&event->y, sizeof(float), 1, file);
+            break;
+            
+        case REPLAY_EVENT_MOUSE_CLICK:
+            fputc(event->code, file);
+            fputc(event->action ? 1 : 0, file);
+            break;
+            
+        case REPLAY_EVENT_PHASE:
+            fputc(event->code, file);
+            break;
+            
+        default:
+            break;
+    }
+    g_replay.event_count++;
+}
+
+void replay_record_stop(unsigned long end_tick, unsigned int checksum) {
+    FILE* file = g_replay.file;
+    if (!file) {
+        return;
+    }
+    
+    uint32_t value = checksum;
+    fputc(REPLAY_EVENT_END, file);
+    write_varint(file, end_tick - g_replay.last_tick);
+    fwrite(&value, sizeof(uint32_t), 1, file);
+    
+    long size = ftell(file);
+    fclose(file);
+    g_replay.file = NULL;
+    printf("Replay: recorded %lu events over %lu ticks (%ld bytes, checksum %08x)\n",
+           g_replay.event_count, end_tick, size, checksum);
+}
+
+int replay_is_recording() {
+    return g_replay.file != NULL;
+}
+
+static int add_entry(unsigned long tick, const ReplayEvent* event, int* capacity) {
+    if (g_replay.entry_count == *capacity) {
+        int new_capacity = *capacity ? *capacity * 2 : REPLAY_INITIAL_EVENTS;
+        ReplayEntry* entries = (ReplayEntry*)realloc(g_replay.entries, sizeof(ReplayEntry) * new_capacity);
+        if (!entries) {
+            return 0;
+        }
+        g_replay.entries = entries;
+        *capacity = new_capacity;
+    }
+    
+    g_replay.entries[g_replay.entry_count].tick = tick;
+    g_replay.entries[g_replay.entry_count].event = *event;
+    g_replay.entry_count++;
+    return 1;
+}
+
+static int parse_events(const unsigned char* cursor, const unsigned char* end) {
+    int capacity = 0;
+    unsigned long tick = 0;
+    
+    while (cursor < end) {
+        ReplayEvent event;
+        memset(&event, 0, sizeof(ReplayEvent));
+        event.type = *cursor++;
+        
+        unsigned long delta;
+        if (!read_varint(&cursor, end, &delta)) {
+            return 0;
+        }
+        tick += delta;
+        
+        unsigned long code;
+        switch (event.type) {
+            case REPLAY_EVENT_KEY:
+                if (!read_varint(&cursor, end, &code) || cursor >= end) {
+                    return 0;
+                }
+                event.code = (int)code;
+                event.action = *cursor++;
+                break;
+            
+            case REPLAY_EVENT_MOUSE_MOVE:
+                if (end - cursor < 2 * (long)sizeof(float)) {
+                    return 0;
+                }
+                memcpy(&event.x, cursor, sizeof(float));
+                memcpy(&event.y, cursor + sizeof(float), sizeof(float));
+                cursor += 2 * sizeof(float);
+                break;
+            
+            case REPLAY_EVENT_MOUSE_CLICK:
+                if (end - cursor < 2) {
+                    return 0;
+                }
+                event.code = cursor[0];
+                event.action = cursor[1];
+                cursor += 2;
+                break;
+            
+            case REPLAY_EVENT_PHASE:
+                if (cursor >= end) {
+                    return 0;
+                }
+                event.code = *cursor++;
+                break;
+            
+            case REPLAY_EVENT_QUIT:
+                break;
+            
+            case REPLAY_EVENT_END: {
+                uint32_t checksum;
+                if (end - cursor < (long)sizeof(uint32_t)) {
+                    return 0;
+                }
+                memcpy(&checksum, cursor, sizeof(uint32_t));
+                g_replay.checksum = checksum;
+                g_replay.end_tick = tick;
+                return 1;
+            }
+            
+            default:
+                return 0;
+        }
+        
+        if (!add_entry(tick, &event, &capacity)) {
+            return 0;
+        }
+    }
+    
+    // No end record: the recording session did not shut down cleanly
+    return 0;
+}
+
+int replay_load(const char* path) {
+    replay_close();
+    
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        printf("Replay: cannot open %s\n", path);
+        return 0;
+    }
+    
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    
+    unsigned char* data = size > 0 ? (unsigned char*)malloc((size_t)size) : NULL;
+    int valid = data && fread(data, 1, (size_t)size, file) == (size_t)size &&
+                size >= (long)sizeof(ReplayHeader);
+    fclose(file);
+    
+    if (valid) {
+        memcpy(&g_replay.header, data, sizeof(ReplayHeader));
+        valid = g_replay.header.magic == REPLAY_MAGIC && g_replay.header.version == REPLAY_VERSION;
+    }
+    if (valid) {
+        valid = parse_events(data + sizeof(ReplayHeader), data + size);
+    }
+    free(data);
+    
+    if (!valid) {
+        printf("Replay: %s is not a complete version %d recording\n", path, REPLAY_VERSION);
+        replay_close();
+        return 0;
+    }
+    
+    g_replay.cursor = 0;
+    g_replay.playing = 1;
+    printf("Replay: loaded %s - %d events over %lu ticks (seed %u)\n",
+           path, g_replay.entry_count, g_replay.end_tick, g_replay.header.seed);
+    return 1;
+}
+
+int replay_is_playing() {
+    return g_replay.playing;
+}
+
+const ReplayHeader* replay_get_header() {
+    return &g_replay.header;
+}
+
+unsigned long replay_end_tick() {
+    return g_replay.end_tick;
+}
+
+unsigned int replay_expected_checksum() {
+    return g_replay.checksum;
+}
+
+int replay_next_event(unsigned long tick, ReplayEvent* event) {
+    if (!g_replay.playing || g_replay.cursor >= g_replay.entry_count) {
+        return 0;
+    }
+    
+    const ReplayEntry* entry = &g_replay.entries[g_replay.cursor];
+    if (entry->tick > tick) {
+        return 0;
+    }
+    
+    *event = entry->event;
+    g_replay.cursor++;
+    return 1;
+}
+
+void replay_close() {
+    free(g_replay.entries);
+    g_replay.entries = NULL;
+    g_replay.entry_count = 0;
+    g_replay.cursor = 0;
+    g_replay.end_tick = 0;
+    g_replay.checksum = 0;
+    g_replay.playing = 0;
+    memset(&g_replay.header, 0, sizeof(ReplayHeader));
+}
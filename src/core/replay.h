@@ -0,0 +1,77 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Input recording and deterministic replay. A recording holds the random
+// seed and entity capacities the session started with, then every input
+// event stamped with the simulation tick it was applied on. Feeding the
+// events back on the same ticks reproduces the session; the end record
+// carries a checksum of the final game state so a replay can tell whether
+// it diverged.
+//
+// File layout (little-endian): a ReplayHeader, then events of one type
+// byte, the tick delta from the previous event as a LEB128 varint and a
+// type specific payload. REPLAY_EVENT_END closes the file.
+
+#define REPLAY_MAGIC 0x50525353u    // "SSRP"
+#define REPLAY_VERSION 1
+
+// Header flags
+#define REPLAY_FLAG_HEADLESS 1      // Recorded by run_headless_loop(), replays with its scripted setup
+
+typedef enum {
+    REPLAY_EVENT_KEY,           // code = key, action = pressed
+    REPLAY_EVENT_MOUSE_MOVE,    // x, y = raw offsets
+    REPLAY_EVENT_MOUSE_CLICK,   // code = button, action = pressed
+    REPLAY_EVENT_PHASE,         // code = GamePhase requested by the UI
+    REPLAY_EVENT_QUIT,          // Quit requested by the UI
+    REPLAY_EVENT_END,           // code = final state checksum
+    REPLAY_EVENT_COUNT
+} ReplayEventType;
+
+typedef struct {
+    int type;
+    int code;
+    int action;
+    float x;
+    float y;
+} ReplayEvent;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t tick_rate;
+    uint32_t seed;
+    uint32_t flags;
+    int32_t max_enemies;
+    int32_t max_projectiles;
+} ReplayHeader;
+
+// Recording. Events must be added in tick order.
+int replay_record_start(const char* path, const ReplayHeader* header);
+void replay_record_event(unsigned long tick, const ReplayEvent* event);
+void replay_record_stop(unsigned long end_tick, unsigned int checksum);
+int replay_is_recording();
+
+// Playback. replay_load() reads the whole file up front, so no I/O happens
+// while ticks run.
+int replay_load(const char* path);
+int replay_is_playing();
+const ReplayHeader* replay_get_header();
+unsigned long replay_end_tick();
+unsigned int replay_expected_checksum();
+
+// Next event recorded for tick, returns 0 once the tick has none left
+int replay_next_event(unsigned long tick, ReplayEvent* event);
+void replay_close(); // Ends playback, recording is ended by replay_record_stop()
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REPLAY_H
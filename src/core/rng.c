@@ -0,0 +1,62 @@
+#include "rng.h"
+#include <stdio.h>
+#include <string.h>
+
+static Rng g_streams[RNG_STREAM_COUNT];
+static uint64_t g_stream_seeds[RNG_STREAM_COUNT];
+static uint32_t g_seed = 0;
+
+static uint64_t splitmix64(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+void rng_seed(Rng* rng, uint64_t seed) {
+    // splitmix64 spreads any seed (including 0) over the whole state
+    uint64_t a = splitmix64(&seed);
+    uint64_t b = splitmix64(&seed);
+    rng->state[0] = (uint32_t)a;
+    rng->state[1] = (uint32_t)(a >> 32);
+    rng->state[2] = (uint32_t)b;
+    rng->state[3] = (uint32_t)(b >> 32);
+}
+
+static void seed_streams(uint32_t seed) {
+    uint64_t state = seed;
+    g_seed = seed;
+    for (int i = 0; i < RNG_STREAM_COUNT; i++) {
+        g_stream_seeds[i] = splitmix64(&state);
+        rng_seed(&g_streams[i], g_stream_seeds[i]);
+    }
+}
+
+void init_rng(uint32_t seed) {
+    seed_streams(seed);
+    printf("Random streams seeded - seed: %u\n", seed);
+}
+
+uint32_t rng_get_seed() {
+    return g_seed;
+}
+
+Rng* rng_stream(RngStream stream) {
+    return &g_streams[stream];
+}
+
+void save_rng_snapshot(RngSnapshot* snapshot) {
+    snapshot->seed = g_seed;
+    memcpy(snapshot->streams, g_streams, sizeof(g_streams));
+}
+
+void load_rng_snapshot(const RngSnapshot* snapshot) {
+    // Fork seeds come from the seed, positions from the snapshot
+    seed_streams(snapshot->seed);
+    memcpy(g_streams, snapshot->streams, sizeof(g_streams));
+}
+
+void rng_fork(Rng* rng, RngStream stream, uint64_t key) {
+    uint64_t state = g_stream_seeds[stream] ^ key;
+    rng_seed(rng, splitmix64(&state));
+}
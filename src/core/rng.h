@@ -0,0 +1,92 @@
+#ifndef RNG_H
+#define RNG_H
+
+// Seeded xoshiro128** generators. Every subsystem draws from its own stream,
+// so the sounds played or effects spawned never change what gameplay rolls
+// next, and the gameplay stream alone reproduces a session from its seed.
+//
+// A stream belongs to the thread that uses it (gameplay, audio and effects
+// all run inside the simulation tick). Parallel jobs must not share one:
+// they fork a private generator with rng_fork(), keyed by something stable
+// such as the tick and entity slot, so results do not depend on scheduling.
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    RNG_STREAM_GAMEPLAY,    // Spawning and anything else that affects the simulation
+    RNG_STREAM_VFX,         // Hit effects
+    RNG_STREAM_AUDIO,       // Pitch and volume variation, noise synthesis
+    RNG_STREAM_COUNT
+} RngStream;
+
+typedef struct {
+    uint32_t state[4];
+} Rng;
+
+// Seed and stream positions, saved with game snapshots
+typedef struct {
+    uint32_t seed;
+    Rng streams[RNG_STREAM_COUNT];
+} RngSnapshot;
+
+// Seed every stream from one seed; set up before any subsystem draws numbers
+void init_rng(uint32_t seed);
+uint32_t rng_get_seed();
+
+Rng* rng_stream(RngStream stream);
+
+void save_rng_snapshot(RngSnapshot* snapshot);
+void load_rng_snapshot(const RngSnapshot* snapshot);
+
+// Generator derived from a stream's seed and key, independent of the
+// stream's current position and of every other key
+void rng_fork(Rng* rng, RngStream stream, uint64_t key);
+void rng_seed(Rng* rng, uint64_t seed);
+
+static __inline uint32_t rng_rotl(uint32_t value, int shift) {
+    return (value << shift) | (value >> (32 - shift));
+}
+
+static __inline uint32_t rng_next(Rng* rng) {
+    uint32_t* s = rng->state;
+    uint32_t result = rng_rotl(s[1] * 5, 7) * 9;
+    uint32_t t = s[1] << 9;
+    
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 11);
+    return result;
+}
+
+// Uniform in [0, 1)
+static __inline float rng_float(Rng* rng) {
+    return (rng_next(rng) >> 8) * (1.0f / 16777216.0f);
+}
+
+// Uniform in [min, max)
+static __inline float rng_range(Rng* rng, float min, float max) {
+    return min + (max - min) * rng_float(rng);
+}
+
+// Uniform in [0, count), count > 0
+static __inline int rng_int(Rng* rng, int count) {
+    return (int)(((uint64_t)rng_next(rng) * (uint32_t)count) >> 32);
+}
+
+// Shorthands for the shared streams
+#define random_float(stream) rng_float(rng_stream(stream))
+#define random_range(stream, min, max) rng_range(rng_stream(stream), (min), (max))
+#define random_int(stream, count) rng_int(rng_stream(stream), (count))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RNG_H
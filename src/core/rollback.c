@@ -0,0 +1,210 @@
+#include "rollback.h"
+#include "snapshot.h"
+#include "game_loop.h"
+#include "game_state.h"
+#include "timer.h"
+#include "log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ROLLBACK_NO_TICK ((unsigned long)-1)
+
+typedef struct {
+    unsigned long tick;         // Tick whose starting state this holds, ROLLBACK_NO_TICK when unused
+    StateSnapshot state;        // Buffer reused every time the slot comes around
+    ReplayEvent events[ROLLBACK_MAX_EVENTS_PER_TICK];
+    int event_count;
+} RollbackFrame;
+
+typedef struct {
+    RollbackFrame* frames;      // Ring indexed by tick % window
+    int window;
+    unsigned long dirty_tick;   // Earliest tick with changed inputs, ROLLBACK_NO_TICK when clean
+    int resimulating;
+    int input_cursor;           // Next event of the tick being run again
+    RollbackStats stats;
+} RollbackState;
+
+static RollbackState g_rollback;
+
+static RollbackFrame* frame_for_tick(unsigned long tick) {
+    if (!g_rollback.frames) {
+        return NULL;
+    }
+    RollbackFrame* frame = &g_rollback.frames[tick % (unsigned long)g_rollback.window];
+    return frame->tick == tick ? frame : NULL;
+}
+
+int init_rollback(int window) {
+    memset(&g_rollback, 0, sizeof(RollbackState));
+    g_rollback.dirty_tick = ROLLBACK_NO_TICK;
+    if (window <= 0) {
+        return 1;
+    }
+    if (window > ROLLBACK_MAX_WINDOW) {
+        window = ROLLBACK_MAX_WINDOW;
+    }
+    
+    g_rollback.frames = (RollbackFrame*)calloc((size_t)window, sizeof(RollbackFrame));
+    if (!g_rollback.frames) {
+        printf("Rollback: failed to allocate %d ticks of history\n", window);
+        return 0;
+    }
+    for (int i = 0; i < window; i++) {
+        g_rollback.frames[i].tick = ROLLBACK_NO_TICK;
+    }
+    g_rollback.window = window;
+    
+    printf("Rollback initialized - %d ticks of history\n", window);
+    return 1;
+}
+
+void cleanup_rollback() {
+    if (!g_rollback.frames) {
+        return;
+    }
+    
+    const RollbackStats* stats = &g_rollback.stats;
+    if (stats->rollbacks > 0) {
+        printf("Rollback: %lu rollbacks, %lu ticks re-simulated (at most %d at once, %.3f ms per tick)\n",
+               stats->rollbacks, stats->resimulated_ticks, stats->max_resimulated,
+               stats->resimulation_time * 1000.0 / (double)stats->resimulated_ticks);
+    }
+    
+    for (int i = 0; i < g_rollback.window; i++) {
+        free_game_snapshot(&g_rollback.frames[i].state);
+    }
+    free(g_rollback.frames);
+    memset(&g_rollback, 0, sizeof(RollbackState));
+    printf("Rollback cleaned up\n");
+}
+
+int rollback_window() {
+    return g_rollback.window;
+}
+
+void rollback_begin_tick(unsigned long tick) {
+    if (!g_rollback.frames) {
+        return;
+    }
+    
+    // Running a tick again refreshes its starting state but keeps its inputs
+    RollbackFrame* frame = &g_rollback.frames[tick % (unsigned long)g_rollback.window];
+    if (!g_rollback.resimulating) {
+        frame->event_count = 0;
+    }
+    frame->tick = save_game_snapshot(&frame->state) ? tick : ROLLBACK_NO_TICK;
+    g_rollback.input_cursor = 0;
+}
+
+void rollback_record_input(unsigned long tick, const ReplayEvent* event) {
+    if (g_rollback.resimulating) {
+        return;
+    }
+    
+    RollbackFrame* frame = frame_for_tick(tick);
+    if (!frame) {
+        return;
+    }
+    if (frame->event_count < ROLLBACK_MAX_EVENTS_PER_TICK) {
+        frame->events[frame->event_count++] = *event;
+    } else {
+        LOG_WARN(LOG_CATEGORY_INPUT, "Rollback: more than %d input events on tick %lu, event dropped",
+                 ROLLBACK_MAX_EVENTS_PER_TICK, tick);
+    }
+}
+
+static int mark_dirty(unsigned long tick) {
+    // Only ticks that have run and are still in the window can be rewound
+    if (!frame_for_tick(tick) || tick >= get_simulation_tick()) {
+        return 0;
+    }
+    if (g_rollback.dirty_tick == ROLLBACK_NO_TICK || tick < g_rollback.dirty_tick) {
+        g_rollback.dirty_tick = tick;
+    }
+    return 1;
+}
+
+int rollback_correct_input(unsigned long tick, const ReplayEvent* events, int count) {
+    if (count < 0 || count > ROLLBACK_MAX_EVENTS_PER_TICK || !mark_dirty(tick)) {
+        return 0;
+    }
+    
+    RollbackFrame* frame = frame_for_tick(tick);
+    memcpy(frame->events, events, sizeof(ReplayEvent) * (size_t)count);
+    frame->event_count = count;
+    return 1;
+}
+
+int rollback_invalidate(unsigned long tick) {
+    return mark_dirty(tick);
+}
+
+int rollback_resimulate() {
+    unsigned long tick = g_rollback.dirty_tick;
+    if (tick == ROLLBACK_NO_TICK) {
+        return 0;
+    }
+    g_rollback.dirty_tick = ROLLBACK_NO_TICK;
+    
+    // The ring may have moved on since the tick was marked
+    unsigned long present = get_simulation_tick();
+    RollbackFrame* frame = frame_for_tick(tick);
+    if (!frame || tick >= present) {
+        return 0;
+    }
+    
+    double start_time = get_current_time();
+    if (!load_game_snapshot(&frame->state)) {
+        return 0;
+    }
+    
+    GameState* game_state = get_game_state();
+    g_rollback.resimulating = 1;
+    while (get_simulation_tick() < present && game_state->game_running) {
+        run_simulation_tick();
+    }
+    g_rollback.resimulating = 0;
+    
+    int ticks = (int)(present - tick);
+    RollbackStats* stats = &g_rollback.stats;
+    stats->rollbacks++;
+    stats->resimulated_ticks += (unsigned long)ticks;
+    stats->resimulation_time += get_current_time() - start_time;
+    if (ticks > stats->max_resimulated) {
+        stats->max_resimulated = ticks;
+    }
+    return ticks;
+}
+
+int rollback_is_resimulating() {
+    return g_rollback.resimulating;
+}
+
+int rollback_next_input(ReplayEvent* event) {
+    RollbackFrame* frame = frame_for_tick(get_simulation_tick());
+    if (!g_rollback.resimulating || !frame || g_rollback.input_cursor >= frame->event_count) {
+        return 0;
+    }
+    
+    *event = frame->events[g_rollback.input_cursor++];
+    return 1;
+}
+
+int rollback_validate_hit(unsigned long tick, const Projectile* projectile, int enemy_handle,
+                          CollisionResult* result) {
+    memset(result, 0, sizeof(CollisionResult));
+    
+    RollbackFrame* frame = frame_for_tick(tick);
+    Enemy enemy;
+    if (!frame || !snapshot_get_enemy(&frame->state, enemy_handle, &enemy) || enemy.ai_state == AI_DEAD) {
+        return 0;
+    }
+    
+    return check_projectile_enemy_collision(projectile, &enemy, result);
+}
+
+const RollbackStats* get_rollback_stats() {
+    return &g_rollback.stats;
+}
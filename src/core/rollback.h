@@ -0,0 +1,71 @@
+#ifndef ROLLBACK_H
+#define ROLLBACK_H
+
+#include "game_api.h"
+#include "replay.h"
+#include "collision_system.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Rollback keeps the state before each of the last N ticks (snapshot.h)
+// together with the input events applied on that tick. Correcting the
+// inputs of a past tick marks it dirty; the next rollback_resimulate()
+// rewinds to it and runs the ticks up to the present again with the
+// corrected inputs, so late remote input changes the present without a
+// visible stall. The same history answers lag compensated hit checks
+// against the world as a client saw it.
+//
+// Everything here runs between ticks on the thread that simulates, under
+// sim_thread_lock() when called from anywhere else.
+
+#define ROLLBACK_MAX_WINDOW 64
+#define ROLLBACK_MAX_EVENTS_PER_TICK 32
+
+typedef struct {
+    unsigned long rollbacks;
+    unsigned long resimulated_ticks;
+    int max_resimulated;        // Most ticks run again by one rollback
+    double resimulation_time;   // Seconds spent in rollback_resimulate()
+} RollbackStats;
+
+// window = ticks of history kept, 0 disables rollback
+int init_rollback(int window);
+void cleanup_rollback();
+int rollback_window();
+
+// Called by run_simulation_tick() before the tick runs
+void rollback_begin_tick(unsigned long tick);
+
+// Input applied live on tick, kept for re-simulation
+void rollback_record_input(unsigned long tick, const ReplayEvent* event);
+
+// Replace the inputs of a past tick (the authoritative ones for a predicted
+// tick); returns 0 when the tick has left the window
+int rollback_correct_input(unsigned long tick, const ReplayEvent* events, int count);
+
+// Re-simulate from tick with unchanged inputs (determinism checks, benchmarks)
+int rollback_invalidate(unsigned long tick);
+
+// Rewind to the earliest dirty tick and run back up to the present, once per
+// frame before new ticks. Returns the ticks run again.
+int rollback_resimulate();
+
+// While re-simulating: the input events for the tick being run again.
+// Presentation (sound, effects) checks rollback_is_resimulating() and stays quiet.
+int rollback_is_resimulating();
+int rollback_next_input(ReplayEvent* event);
+
+// Lag compensation: test projectile against enemy_handle where the enemy was
+// when tick began. Returns 0 on a miss or when tick has left the window.
+int rollback_validate_hit(unsigned long tick, const Projectile* projectile, int enemy_handle,
+                          CollisionResult* result);
+
+const RollbackStats* get_rollback_stats();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ROLLBACK_H
@@ -0,0 +1,265 @@
+#include "sim_thread.h"
+#include "game_loop.h"
+#include "game_state.h"
+#include "arena.h"
+#include "atomics.h"
+#include "timer.h"
+#include "trace.h"
+#include "frame_stats.h"
+#include "rollback.h"
+#include "../audio_bridge.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#define SIM_THREAD_RETURN DWORD WINAPI
+typedef HANDLE sim_thread_t;
+typedef CRITICAL_SECTION sim_mutex_t;
+#define sim_mutex_init(m) InitializeCriticalSection(m)
+#define sim_mutex_destroy(m) DeleteCriticalSection(m)
+#define sim_mutex_lock(m) EnterCriticalSection(m)
+#define sim_mutex_unlock(m) LeaveCriticalSection(m)
+#else
+#include <pthread.h>
+#define SIM_THREAD_RETURN void*
+typedef pthread_t sim_thread_t;
+typedef pthread_mutex_t sim_mutex_t;
+#define sim_mutex_init(m) pthread_mutex_init(m, NULL)
+#define sim_mutex_destroy(m) pthread_mutex_destroy(m)
+#define sim_mutex_lock(m) pthread_mutex_lock(m)
+#define sim_mutex_unlock(m) pthread_mutex_unlock(m)
+#endif
+
+// The shared slot holds the index of the buffer between writer and reader,
+// plus a flag telling the reader it has not been taken yet
+#define SNAPSHOT_BUFFER_COUNT 3
+#define SNAPSHOT_INDEX_MASK 3
+#define SNAPSHOT_FRESH 4
+
+typedef struct {
+    GameSnapshot snapshots[SNAPSHOT_BUFFER_COUNT];
+    Arena arena;                // Entity storage for all snapshots
+    
+    volatile int32_t shared;    // Middle buffer index | SNAPSHOT_FRESH
+    int write_index;            // Owned by the simulation thread
+    int read_index;             // Owned by the main thread
+    
+    volatile int32_t stop;
+    int running;
+    sim_thread_t thread;
+    sim_mutex_t lock;
+} SimThreadState;
+
+static SimThreadState g_sim;
+
+// Snapshot pools carry the alive list for iteration plus the per-slot
+// alive_index and generations that renderers use to tell slots apart
+#define SNAPSHOT_POOL_ARRAYS 3
+
+static int allocate_pool(EntityPool* pool, int capacity) {
+    Arena* arena = &g_sim.arena;
+    pool->alive = (int*)arena_alloc(arena, (size_t)capacity * sizeof(int), 0);
+    pool->alive_index = (int*)arena_alloc(arena, (size_t)capacity * sizeof(int), 0);
+    pool->generations = (int*)arena_alloc(arena, (size_t)capacity * sizeof(int), 0);
+    return pool->alive && pool->alive_index && pool->generations;
+}
+
+static int allocate_snapshot(GameSnapshot* snapshot, const GameState* live) {
+    Arena* arena = &g_sim.arena;
+    snapshot->state.enemies = (Enemy*)arena_alloc_zeroed(arena, (size_t)live->max_enemies * sizeof(Enemy), 0);
+    snapshot->state.projectiles = (Projectile*)arena_alloc_zeroed(arena, (size_t)live->max_projectiles * sizeof(Projectile), 0);
+    
+    return snapshot->state.enemies && snapshot->state.projectiles &&
+           allocate_pool(&snapshot->state.enemy_pool, live->max_enemies) &&
+           allocate_pool(&snapshot->state.projectile_pool, live->max_projectiles);
+}
+
+static void copy_pool(EntityPool* target, const EntityPool* source) {
+    EntityPool storage = *target;
+    memset(target, 0, sizeof(EntityPool));
+    target->capacity = source->capacity;
+    target->count = source->count;
+    target->alive = storage.alive;
+    target->alive_index = storage.alive_index;
+    target->generations = storage.generations;
+    memcpy(target->alive, source->alive, (size_t)source->count * sizeof(int));
+    memcpy(target->alive_index, source->alive_index, (size_t)source->capacity * sizeof(int));
+    memcpy(target->generations, source->generations, (size_t)source->capacity * sizeof(int));
+}
+
+// Only live slots are copied, stale slots are never read through the alive lists
+static void take_snapshot(GameSnapshot* snapshot, const GameState* live) {
+    Enemy* enemies = snapshot->state.enemies;
+    Projectile* projectiles = snapshot->state.projectiles;
+    EntityPool enemy_pool = snapshot->state.enemy_pool;
+    EntityPool projectile_pool = snapshot->state.projectile_pool;
+    
+    snapshot->state = *live;
+    snapshot->state.enemies = enemies;
+    snapshot->state.projectiles = projectiles;
+    snapshot->state.enemy_pool = enemy_pool;
+    snapshot->state.projectile_pool = projectile_pool;
+    
+    copy_pool(&snapshot->state.enemy_pool, &live->enemy_pool);
+    copy_pool(&snapshot->state.projectile_pool, &live->projectile_pool);
+    
+    for (int i = 0; i < live->enemy_pool.count; i++) {
+        int slot = live->enemy_pool.alive[i];
+        enemies[slot] = live->enemies[slot];
+    }
+    for (int i = 0; i < live->projectile_pool.count; i++) {
+        int slot = live->projectile_pool.alive[i];
+        projectiles[slot] = live->projectiles[slot];
+    }
+    
+    snapshot->tick = get_simulation_tick();
+}
+
+static void publish_snapshot() {
+    int32_t previous = atomic_exchange_i32(&g_sim.shared, g_sim.write_index | SNAPSHOT_FRESH);
+    g_sim.write_index = previous & SNAPSHOT_INDEX_MASK;
+}
+
+GameSnapshot* sim_thread_acquire_snapshot() {
+    if (atomic_load_i32(&g_sim.shared) & SNAPSHOT_FRESH) {
+        int32_t previous = atomic_exchange_i32(&g_sim.shared, g_sim.read_index);
+        g_sim.read_index = previous & SNAPSHOT_INDEX_MASK;
+    }
+    return &g_sim.snapshots[g_sim.read_index];
+}
+
+#ifdef _WIN32
+static SIM_THREAD_RETURN sim_thread_main(LPVOID param) {
+#else
+static SIM_THREAD_RETURN sim_thread_main(void* param) {
+#endif
+    (void)param;
+    trace_set_thread_name("simulation");
+    
+    GameState* game_state = get_game_state();
+    double next_tick_time = get_current_time() + SIMULATION_TICK_TIME;
+    
+    while (!atomic_load_i32(&g_sim.stop)) {
+        wait_until(next_tick_time);
+        double now = get_current_time();
+        
+        // Run every tick that is due, same catch-up limit as the main loop
+        double batch_start = now;
+        int ticks = 0;
+        sim_mutex_lock(&g_sim.lock);
+        rollback_resimulate();
+        while (next_tick_time <= now && ticks < MAX_TICKS_PER_FRAME && game_state->game_running) {
+            run_simulation_tick();
+            next_tick_time += SIMULATION_TICK_TIME;
+            ticks++;
+        }
+        update_audio_system(game_state, (float)(ticks * SIMULATION_TICK_TIME));
+        
+        GameSnapshot* snapshot = &g_sim.snapshots[g_sim.write_index];
+        take_snapshot(snapshot, game_state);
+        snapshot->tick_time = next_tick_time - SIMULATION_TICK_TIME;
+        int game_running = game_state->game_running;
+        sim_mutex_unlock(&g_sim.lock);
+        
+        publish_snapshot();
+        frame_stats_record(FRAME_STAT_SIMULATION, get_current_time() - batch_start);
+        
+        // Too far behind: drop the missed ticks, the game runs slower than real time
+        if (next_tick_time <= now) {
+            next_tick_time = now + SIMULATION_TICK_TIME;
+        }
+        
+        // Quitting from gameplay ends the thread, the main loop sees it in the last snapshot
+        if (!game_running) {
+            break;
+        }
+    }
+    return 0;
+}
+
+int start_sim_thread() {
+    if (g_sim.running) {
+        return 1;
+    }
+    
+    GameState* live = get_game_state();
+    size_t snapshot_size = (size_t)live->max_enemies * (sizeof(Enemy) + SNAPSHOT_POOL_ARRAYS * sizeof(int)) +
+                           (size_t)live->max_projectiles * (sizeof(Projectile) + SNAPSHOT_POOL_ARRAYS * sizeof(int)) +
+                           (2 + 2 * SNAPSHOT_POOL_ARRAYS) * ARENA_DEFAULT_ALIGNMENT;
+    if (!arena_init(&g_sim.arena, snapshot_size * SNAPSHOT_BUFFER_COUNT)) {
+        printf("Simulation thread: failed to allocate snapshots\n");
+        return 0;
+    }
+    
+    // Every buffer starts as a copy of the current state, so the first
+    // acquire already has something to draw
+    for (int i = 0; i < SNAPSHOT_BUFFER_COUNT; i++) {
+        if (!allocate_snapshot(&g_sim.snapshots[i], live)) {
+            printf("Simulation thread: failed to allocate snapshots\n");
+            arena_destroy(&g_sim.arena);
+            return 0;
+        }
+        take_snapshot(&g_sim.snapshots[i], live);
+        g_sim.snapshots[i].tick_time = get_current_time();
+    }
+    g_sim.write_index = 0;
+    g_sim.shared = 1;
+    g_sim.read_index = 2;
+    g_sim.stop = 0;
+    
+    sim_mutex_init(&g_sim.lock);
+#ifdef _WIN32
+    g_sim.thread = CreateThread(NULL, 0, sim_thread_main, NULL, 0, NULL);
+    int started = g_sim.thread != NULL;
+#else
+    int started = pthread_create(&g_sim.thread, NULL, sim_thread_main, NULL) == 0;
+#endif
+    if (!started) {
+        printf("Simulation thread: failed to start, simulating on the main thread\n");
+        sim_mutex_destroy(&g_sim.lock);
+        arena_destroy(&g_sim.arena);
+        return 0;
+    }
+    
+    g_sim.running = 1;
+    printf("Simulation thread started - %d Hz, triple-buffered snapshots (%zu bytes)\n",
+           SIMULATION_TICK_RATE, g_sim.arena.used);
+    return 1;
+}
+
+void stop_sim_thread() {
+    if (!g_sim.running) {
+        return;
+    }
+    
+    atomic_store_i32(&g_sim.stop, 1);
+#ifdef _WIN32
+    WaitForSingleObject(g_sim.thread, INFINITE);
+    CloseHandle(g_sim.thread);
+#else
+    pthread_join(g_sim.thread, NULL);
+#endif
+    g_sim.running = 0;
+    
+    sim_mutex_destroy(&g_sim.lock);
+    arena_destroy(&g_sim.arena);
+    memset(g_sim.snapshots, 0, sizeof(g_sim.snapshots));
+    printf("Simulation thread stopped\n");
+}
+
+int sim_thread_running() {
+    return g_sim.running;
+}
+
+void sim_thread_lock() {
+    if (g_sim.running) {
+        sim_mutex_lock(&g_sim.lock);
+    }
+}
+
+void sim_thread_unlock() {
+    if (g_sim.running) {
+        sim_mutex_unlock(&g_sim.lock);
+    }
+}
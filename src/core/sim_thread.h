@@ -0,0 +1,38 @@
+#ifndef SIM_THREAD_H
+#define SIM_THREAD_H
+
+#include "game_api.h"
+
+// Runs the fixed simulation ticks on a dedicated thread while the main
+// thread renders. After every batch of ticks the simulation copies the live
+// GameState into a snapshot and publishes it through a triple buffer, so
+// the renderer always has a complete, unchanging state to draw from and
+// neither side ever waits on the other.
+
+typedef struct {
+    GameState state;        // Entity arrays and pool alive lists point into this snapshot
+    double tick_time;       // Scheduled time of the snapshot's last tick
+    unsigned long tick;     // Simulation tick the snapshot was taken after
+} GameSnapshot;
+
+// Snapshot pools carry count, the alive list, alive_index and generations,
+// enough to iterate and to check slot identity. Their free lists are NULL.
+
+// Start ticking from the current live state. Returns 0 when the thread
+// cannot be created, the caller then keeps simulating itself.
+int start_sim_thread();
+void stop_sim_thread();
+int sim_thread_running();
+
+// Latest published snapshot. It belongs to the caller (the main thread)
+// until the next call, which may return the same one if nothing newer is
+// ready.
+GameSnapshot* sim_thread_acquire_snapshot();
+
+// Exclude simulation ticks while the main thread touches shared systems
+// (starting or stopping a trace capture). No-ops when the thread is not
+// running.
+void sim_thread_lock();
+void sim_thread_unlock();
+
+#endif // SIM_THREAD_H
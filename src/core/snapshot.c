@@ -0,0 +1,454 @@
+#include "snapshot.h"
+#include "game_state.h"
+#include "game_loop.h"
+#include "object_manager.h"
+#include "input_manager.h"
+#include "entity_pool.h"
+#include "enemy_ai.h"
+#include "rng.h"
+#include "../physics_bridge.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Runs shorter than this stay inside a literal, a new token costs two varints
+#define DELTA_MIN_ZERO_RUN 4
+
+// Layout: SnapshotCore, then enemy pool storage, projectile pool storage,
+// Enemy[max_enemies], EnemyAI[max_enemies], Projectile[max_projectiles] and
+// physics_size bytes of physics state
+typedef struct {
+    uint32_t version;
+    uint32_t enemy_size;            // Struct sizes of the build that saved it
+    uint32_t enemy_ai_size;
+    uint32_t projectile_size;
+    uint32_t physics_size;
+    int32_t max_enemies;
+    int32_t max_projectiles;
+    uint32_t checksum;
+    
+    int32_t score;
+    int32_t game_running;
+    int32_t current_phase;
+    float delta_time;
+    PlayerState player;
+    
+    int32_t enemy_count;            // Pool bookkeeping, the pool arrays follow
+    int32_t enemy_free_count;
+    int32_t projectile_count;
+    int32_t projectile_free_count;
+    
+    LoopSnapshot loop;
+    ObjectManagerSnapshot objects;
+    InputSnapshot input;
+    RngSnapshot rng;
+} SnapshotCore;
+
+static size_t snapshot_size(const SnapshotCore* core) {
+    return sizeof(SnapshotCore) +
+           entity_pool_storage_size(core->max_enemies) +
+           entity_pool_storage_size(core->max_projectiles) +
+           (size_t)core->max_enemies * (sizeof(Enemy) + sizeof(EnemyAI)) +
+           (size_t)core->max_projectiles * sizeof(Projectile) +
+           core->physics_size;
+}
+
+static int reserve(unsigned char** data, size_t* capacity, size_t size) {
+    if (*capacity >= size) {
+        return 1;
+    }
+    
+    size_t new_capacity = *capacity ? *capacity : 4096;
+    while (new_capacity < size) {
+        new_capacity *= 2;
+    }
+    unsigned char* grown = (unsigned char*)realloc(*data, new_capacity);
+    if (!grown) {
+        return 0;
+    }
+    *data = grown;
+    *capacity = new_capacity;
+    return 1;
+}
+
+// Copies the core out of a snapshot and checks it fits this build
+static int read_core(const StateSnapshot* snapshot, SnapshotCore* core) {
+    if (!snapshot->data || snapshot->size < sizeof(SnapshotCore)) {
+        return 0;
+    }
+    memcpy(core, snapshot->data, sizeof(SnapshotCore));
+    
+    return core->version == SNAPSHOT_VERSION &&
+           core->enemy_size == sizeof(Enemy) &&
+           core->enemy_ai_size == sizeof(EnemyAI) &&
+           core->projectile_size == sizeof(Projectile) &&
+           core->max_enemies > 0 && core->max_enemies <= MAX_ENTITY_CAPACITY &&
+           core->max_projectiles > 0 && core->max_projectiles <= MAX_ENTITY_CAPACITY &&
+           snapshot->size == snapshot_size(core);
+}
+
+int save_game_snapshot(StateSnapshot* snapshot) {
+    GameState* game_state = get_game_state();
+    EnemyAI* enemy_ai = (EnemyAI*)get_enemy_ai_components();
+    if (!game_state->enemies || !game_state->projectiles || !enemy_ai) {
+        return 0;
+    }
+    
+    SnapshotCore core;
+    memset(&core, 0, sizeof(SnapshotCore));
+    core.version = SNAPSHOT_VERSION;
+    core.enemy_size = sizeof(Enemy);
+    core.enemy_ai_size = sizeof(EnemyAI);
+    core.projectile_size = sizeof(Projectile);
+    core.physics_size = (uint32_t)save_physics_snapshot(NULL, 0);
+    core.max_enemies = game_state->max_enemies;
+    core.max_projectiles = game_state->max_projectiles;
+    core.checksum = compute_game_state_checksum(game_state);
+    
+    core.score = game_state->score;
+    core.game_running = game_state->game_running;
+    core.current_phase = game_state->current_phase;
+    core.delta_time = game_state->delta_time;
+    core.player = game_state->player;
+    
+    core.enemy_count = game_state->enemy_pool.count;
+    core.enemy_free_count = game_state->enemy_pool.free_count;
+    core.projectile_count = game_state->projectile_pool.count;
+    core.projectile_free_count = game_state->projectile_pool.free_count;
+    
+    save_loop_snapshot(&core.loop);
+    save_object_manager_snapshot(&core.objects);
+    save_input_snapshot(&core.input);
+    save_rng_snapshot(&core.rng);
+    
+    size_t size = snapshot_size(&core);
+    if (!reserve(&snapshot->data, &snapshot->capacity, size)) {
+        printf("Snapshot: failed to allocate %zu bytes\n", size);
+        return 0;
+    }
+    
+    unsigned char* cursor = snapshot->data;
+    size_t enemy_pool_size = entity_pool_storage_size(core.max_enemies);
+    size_t projectile_pool_size = entity_pool_storage_size(core.max_projectiles);
+    
+    memcpy(cursor, &core, sizeof(SnapshotCore));
+    cursor += sizeof(SnapshotCore);
+    memcpy(cursor, game_state->enemy_pool.free_slots, enemy_pool_size);
+    cursor += enemy_pool_size;
+    memcpy(cursor, game_state->projectile_pool.free_slots, projectile_pool_size);
+    cursor += projectile_pool_size;
+    memcpy(cursor, game_state->enemies, (size_t)core.max_enemies * sizeof(Enemy));
+    cursor += (size_t)core.max_enemies * sizeof(Enemy);
+    memcpy(cursor, enemy_ai, (size_t)core.max_enemies * sizeof(EnemyAI));
+    cursor += (size_t)core.max_enemies * sizeof(EnemyAI);
+    memcpy(cursor, game_state->projectiles, (size_t)core.max_projectiles * sizeof(Projectile));
+    cursor += (size_t)core.max_projectiles * sizeof(Projectile);
+    save_physics_snapshot(cursor, core.physics_size);
+    
+    snapshot->size = size;
+    snapshot->tick = core.loop.tick_count;
+    snapshot->checksum = core.checksum;
+    return 1;
+}
+
+int load_game_snapshot(const StateSnapshot* snapshot) {
+    GameState* game_state = get_game_state();
+    EnemyAI* enemy_ai = (EnemyAI*)get_enemy_ai_components();
+    
+    SnapshotCore core;
+    if (!read_core(snapshot, &core)) {
+        printf("Snapshot: not a version %d snapshot from this build\n", SNAPSHOT_VERSION);
+        return 0;
+    }
+    if (core.max_enemies != game_state->max_enemies || core.max_projectiles != game_state->max_projectiles ||
+        !enemy_ai) {
+        printf("Snapshot: saved with capacities %d/%d, the level has %d/%d\n",
+               core.max_enemies, core.max_projectiles, game_state->max_enemies, game_state->max_projectiles);
+        return 0;
+    }
+    
+    const unsigned char* cursor = snapshot->data + sizeof(SnapshotCore);
+    size_t enemy_pool_size = entity_pool_storage_size(core.max_enemies);
+    size_t projectile_pool_size = entity_pool_storage_size(core.max_projectiles);
+    const unsigned char* physics = snapshot->data + snapshot->size - core.physics_size;
+    
+    // Physics can still refuse the data, so it goes first
+    if (!load_physics_snapshot(physics, core.physics_size)) {
+        printf("Snapshot: physics state rejected\n");
+        return 0;
+    }
+    
+    memcpy(game_state->enemy_pool.free_slots, cursor, enemy_pool_size);
+    cursor += enemy_pool_size;
+    memcpy(game_state->projectile_pool.free_slots, cursor, projectile_pool_size);
+    cursor += projectile_pool_size;
+    memcpy(game_state->enemies, cursor, (size_t)core.max_enemies * sizeof(Enemy));
+    cursor += (size_t)core.max_enemies * sizeof(Enemy);
+    memcpy(enemy_ai, cursor, (size_t)core.max_enemies * sizeof(EnemyAI));
+    cursor += (size_t)core.max_enemies * sizeof(EnemyAI);
+    memcpy(game_state->projectiles, cursor, (size_t)core.max_projectiles * sizeof(Projectile));
+    
+    game_state->enemy_pool.count = core.enemy_count;
+    game_state->enemy_pool.free_count = core.enemy_free_count;
+    game_state->projectile_pool.count = core.projectile_count;
+    game_state->projectile_pool.free_count = core.projectile_free_count;
+    game_state->enemy_count = core.enemy_count;
+    game_state->projectile_count = core.projectile_count;
+    
+    game_state->score = core.score;
+    game_state->game_running = core.game_running;
+    game_state->current_phase = (GamePhase)core.current_phase;
+    game_state->delta_time = core.delta_time;
+    game_state->player = core.player;
+    
+    load_loop_snapshot(&core.loop);
+    load_input_snapshot(&core.input);
+    load_rng_snapshot(&core.rng);
+    
+    // Last: relinks AI components and rebuilds the caches from the restored pools
+    load_object_manager_snapshot(&core.objects);
+    return 1;
+}
+
+void free_game_snapshot(StateSnapshot* snapshot) {
+    free(snapshot->data);
+    memset(snapshot, 0, sizeof(StateSnapshot));
+}
+
+int snapshot_get_capacities(const StateSnapshot* snapshot, int* max_enemies, int* max_projectiles) {
+    SnapshotCore core;
+    if (!read_core(snapshot, &core)) {
+        return 0;
+    }
+    *max_enemies = core.max_enemies;
+    *max_projectiles = core.max_projectiles;
+    return 1;
+}
+
+int snapshot_get_enemy(const StateSnapshot* snapshot, int handle, Enemy* enemy) {
+    SnapshotCore core;
+    int slot = entity_handle_slot(handle);
+    if (handle < 0 || !read_core(snapshot, &core) || slot >= core.max_enemies) {
+        return 0;
+    }
+    
+    // Pool storage is free_slots, alive, alive_index, generations (entity_pool_init)
+    const unsigned char* pool = snapshot->data + sizeof(SnapshotCore);
+    int alive_index, generation;
+    memcpy(&alive_index, pool + ((size_t)core.max_enemies * 2 + slot) * sizeof(int), sizeof(int));
+    memcpy(&generation, pool + ((size_t)core.max_enemies * 3 + slot) * sizeof(int), sizeof(int));
+    if (alive_index < 0 || generation != entity_handle_generation(handle)) {
+        return 0;
+    }
+    
+    const unsigned char* enemies = pool + entity_pool_storage_size(core.max_enemies) +
+                                   entity_pool_storage_size(core.max_projectiles);
+    memcpy(enemy, enemies + (size_t)slot * sizeof(Enemy), sizeof(Enemy));
+    return 1;
+}
+
+static size_t write_varint(unsigned char* out, size_t value) {
+    size_t length = 0;
+    while (value >= 0x80) {
+        out[length++] = (unsigned char)(value & 0x7F) | 0x80;
+        value >>= 7;
+    }
+    out[length++] = (unsigned char)value;
+    return length;
+}
+
+static int read_varint(const unsigned char** cursor, const unsigned char* end, size_t* value) {
+    size_t result = 0;
+    int shift = 0;
+    while (*cursor < end && shift < 64) {
+        unsigned char byte = *(*cursor)++;
+        result |= (size_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return 1;
+        }
+        shift += 7;
+    }
+    return 0;
+}
+
+static unsigned char base_byte(const StateSnapshot* base, size_t index) {
+    return (base && index < base->size) ? base->data[index] : 0;
+}
+
+size_t snapshot_encode_delta(const StateSnapshot* snapshot, const StateSnapshot* base,
+                             unsigned char** out, size_t* out_capacity) {
+    const unsigned char* data = snapshot->data;
+    size_t size = snapshot->size;
+    
+    // A token is two varints plus its literal, literals only end at a zero
+    // run of DELTA_MIN_ZERO_RUN, so this bounds the output
+    size_t bound = 10 + size + (size / DELTA_MIN_ZERO_RUN + 1) * 20;
+    if (!reserve(out, out_capacity, bound)) {
+        return 0;
+    }
+    
+    unsigned char* output = *out;
+    size_t length = write_varint(output, size);
+    size_t i = 0;
+    while (i < size) {
+        size_t zero_start = i;
+        while (i < size && data[i] == base_byte(base, i)) {
+            i++;
+        }
+        size_t zeros = i - zero_start;
+        
+        // Extend the literal over short zero runs
+        size_t literal_start = i;
+        while (i < size) {
+            size_t run = 0;
+            while (i + run < size && run < DELTA_MIN_ZERO_RUN && data[i + run] == base_byte(base, i + run)) {
+                run++;
+            }
+            if (run == DELTA_MIN_ZERO_RUN || i + run == size) {
+                break;
+            }
+            i += run + 1;
+        }
+        size_t literals = i - literal_start;
+        
+        length += write_varint(output + length, zeros);
+        length += write_varint(output + length, literals);
+        for (size_t j = literal_start; j < i; j++) {
+            output[length++] = data[j] ^ base_byte(base, j);
+        }
+    }
+    return length;
+}
+
+int snapshot_decode_delta(const unsigned char* delta, size_t delta_size, const StateSnapshot* base,
+                          StateSnapshot* snapshot) {
+    const unsigned char* cursor = delta;
+    const unsigned char* end = delta + delta_size;
+    
+    size_t size;
+    if (!read_varint(&cursor, end, &size) || !reserve(&snapshot->data, &snapshot->capacity, size)) {
+        return 0;
+    }
+    
+    unsigned char* data = snapshot->data;
+    size_t position = 0;
+    while (position < size) {
+        size_t zeros, literals;
+        if (!read_varint(&cursor, end, &zeros) || !read_varint(&cursor, end, &literals) ||
+            zeros > size - position || literals > size - position - zeros ||
+            literals > (size_t)(end - cursor)) {
+            return 0;
+        }
+        
+        for (size_t i = 0; i < zeros; i++, position++) {
+            data[position] = base_byte(base, position);
+        }
+        for (size_t i = 0; i < literals; i++, position++) {
+            data[position] = *cursor++ ^ base_byte(base, position);
+        }
+    }
+    snapshot->size = size;
+    
+    SnapshotCore core;
+    if (!read_core(snapshot, &core)) {
+        return 0;
+    }
+    snapshot->tick = core.loop.tick_count;
+    snapshot->checksum = core.checksum;
+    return 1;
+}
+
+int write_game_snapshot(const char* path, const StateSnapshot* snapshot, const StateSnapshot* base) {
+    unsigned char* delta = NULL;
+    size_t delta_capacity = 0;
+    const unsigned char* payload = snapshot->data;
+    size_t payload_size = snapshot->size;
+    
+    if (base) {
+        payload_size = snapshot_encode_delta(snapshot, base, &delta, &delta_capacity);
+        payload = delta;
+        if (payload_size == 0) {
+            free(delta);
+            return 0;
+        }
+    }
+    
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        printf("Snapshot: cannot open %s for writing\n", path);
+        free(delta);
+        return 0;
+    }
+    
+    SnapshotFileHeader header;
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.flags = base ? SNAPSHOT_FLAG_DELTA : 0;
+    header.stored_size = (uint32_t)payload_size;
+    header.base_checksum = base ? base->checksum : 0;
+    
+    int written = fwrite(&header, sizeof(SnapshotFileHeader), 1, file) == 1 &&
+                  fwrite(payload, 1, payload_size, file) == payload_size;
+    fclose(file);
+    free(delta);
+    
+    if (!written) {
+        printf("Snapshot: failed to write %s\n", path);
+    }
+    return written;
+}
+
+int read_game_snapshot(const char* path, StateSnapshot* snapshot, const StateSnapshot* base) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        printf("Snapshot: cannot open %s\n", path);
+        return 0;
+    }
+    
+    fseek(file, 0, SEEK_END);
+    long file_size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    
+    // The payload is the rest of the file, so a corrupt stored_size is
+    // caught before it sizes an allocation
+    SnapshotFileHeader header;
+    unsigned char* payload = NULL;
+    int valid = fread(&header, sizeof(SnapshotFileHeader), 1, file) == 1 &&
+                header.magic == SNAPSHOT_MAGIC && header.version == SNAPSHOT_VERSION &&
+                file_size >= (long)sizeof(SnapshotFileHeader) &&
+                (unsigned long)header.stored_size == (unsigned long)file_size - sizeof(SnapshotFileHeader);
+    if (valid) {
+        payload = (unsigned char*)malloc(header.stored_size > 0 ? header.stored_size : 1);
+        valid = payload && fread(payload, 1, header.stored_size, file) == header.stored_size;
+    }
+    fclose(file);
+    
+    if (valid && (header.flags & SNAPSHOT_FLAG_DELTA)) {
+        if (!base || base->checksum != header.base_checksum) {
+            printf("Snapshot: %s is a delta against a different base\n", path);
+            free(payload);
+            return 0;
+        }
+        valid = snapshot_decode_delta(payload, header.stored_size, base, snapshot);
+    } else if (valid) {
+        valid = reserve(&snapshot->data, &snapshot->capacity, header.stored_size);
+        if (valid) {
+            memcpy(snapshot->data, payload, header.stored_size);
+            snapshot->size = header.stored_size;
+            
+            SnapshotCore core;
+            valid = read_core(snapshot, &core);
+            if (valid) {
+                snapshot->tick = core.loop.tick_count;
+                snapshot->checksum = core.checksum;
+            }
+        }
+    }
+    free(payload);
+    
+    if (!valid) {
+        printf("Snapshot: %s is not a version %d snapshot from this build\n", path, SNAPSHOT_VERSION);
+    }
+    return valid;
+}
@@ -0,0 +1,74 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "game_api.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Save and restore the whole simulation: GameState and its entity pools,
+// the enemy AI components, object manager scheduling and spawn timers,
+// input state, the random streams, the loop's tick and the physics engine
+// (rigid bodies and bunny hop tuning). Entity arrays are stored whole, slot
+// by slot, so a save is a handful of memcpy calls and two saves of the same
+// level line up byte for byte, which keeps deltas between them small.
+//
+// Snapshots belong to the build that wrote them: struct sizes are checked
+// on load and a mismatch is rejected.
+
+#define SNAPSHOT_MAGIC 0x4E535353u      // "SSSN"
+#define SNAPSHOT_VERSION 3
+
+// File header flags
+#define SNAPSHOT_FLAG_DELTA 1           // Stored as a delta against a base snapshot
+
+typedef struct {
+    unsigned char* data;        // Serialized state, reused by the next save
+    size_t size;
+    size_t capacity;
+    unsigned long tick;         // Simulation tick the state was saved after
+    unsigned int checksum;      // compute_game_state_checksum() when saved
+} StateSnapshot;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags;
+    uint32_t stored_size;       // Bytes following the header
+    uint32_t base_checksum;     // Checksum of the base snapshot for deltas
+} SnapshotFileHeader;
+
+// Capture and restore between ticks (inside sim_thread_lock() while the
+// simulation thread runs). Loading needs the entity capacities the snapshot
+// was saved with. Both return 0 on failure; a failed load leaves the state
+// untouched.
+int save_game_snapshot(StateSnapshot* snapshot);
+int load_game_snapshot(const StateSnapshot* snapshot);
+void free_game_snapshot(StateSnapshot* snapshot);
+
+// Capacities a snapshot was saved with, for set_entity_capacities()
+int snapshot_get_capacities(const StateSnapshot* snapshot, int* max_enemies, int* max_projectiles);
+
+// Enemy behind handle as saved, 0 when the handle was not live then
+int snapshot_get_enemy(const StateSnapshot* snapshot, int handle, Enemy* enemy);
+
+// Delta encoding: XOR against base, then run-length encode the unchanged
+// (zero) bytes. out grows as needed; returns the encoded size, 0 on failure.
+size_t snapshot_encode_delta(const StateSnapshot* snapshot, const StateSnapshot* base,
+                             unsigned char** out, size_t* out_capacity);
+int snapshot_decode_delta(const unsigned char* delta, size_t delta_size, const StateSnapshot* base,
+                          StateSnapshot* snapshot);
+
+// Files, stored as a delta when base is given. A delta file can only be
+// read back with the same base.
+int write_game_snapshot(const char* path, const StateSnapshot* snapshot, const StateSnapshot* base);
+int read_game_snapshot(const char* path, StateSnapshot* snapshot, const StateSnapshot* base);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SNAPSHOT_H
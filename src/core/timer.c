@@ -0,0 +1,135 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L // clock_gettime, nanosleep
+#endif
+
+#include "timer.h"
+#include "atomics.h"
+#include <stdio.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <mmsystem.h> // timeBeginPeriod, links winmm
+#else
+#include <time.h>
+#endif
+
+// Spin threshold bounds. Sleeps overshoot by up to one scheduler quantum
+// (about 1 ms on Linux, 1-2 ms on Windows at 1 ms timer resolution).
+#define SPIN_THRESHOLD_MIN 0.0002
+#define SPIN_THRESHOLD_MAX 0.004
+#define SPIN_THRESHOLD_DECAY 0.99   // Per sleep, lets the threshold shrink after a bad patch
+#define CALIBRATION_SLEEPS 10
+
+// Shared by every thread that paces itself, in microseconds so it can be
+// read and written atomically. Updates from two threads may overwrite each
+// other, which only delays adaptation by one sleep.
+static volatile int32_t g_spin_threshold_us = 2000;
+
+#ifdef _WIN32
+static double g_counter_period = 0.0; // Seconds per performance counter tick
+static int g_timer_period_set = 0;
+#endif
+
+double get_current_time() {
+#ifdef _WIN32
+    LARGE_INTEGER counter;
+    if (g_counter_period == 0.0) {
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        g_counter_period = 1.0 / (double)frequency.QuadPart;
+    }
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart * g_counter_period;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + now.tv_nsec / 1000000000.0;
+#endif
+}
+
+void sleep_ms(int milliseconds) {
+#ifdef _WIN32
+    Sleep(milliseconds);
+#else
+    struct timespec duration;
+    duration.tv_sec = milliseconds / 1000;
+    duration.tv_nsec = (long)(milliseconds % 1000) * 1000000L;
+    nanosleep(&duration, NULL);
+#endif
+}
+
+static void sleep_seconds(double seconds) {
+#ifdef _WIN32
+    DWORD milliseconds = (DWORD)(seconds * 1000.0);
+    Sleep(milliseconds > 0 ? milliseconds : 1);
+#else
+    struct timespec duration;
+    duration.tv_sec = (time_t)seconds;
+    duration.tv_nsec = (long)((seconds - (double)duration.tv_sec) * 1000000000.0);
+    nanosleep(&duration, NULL);
+#endif
+}
+
+// Track the worst recent overshoot, decaying slowly so a single slow
+// wakeup does not force long spins forever
+static void record_sleep_overshoot(double overshoot) {
+    double threshold = get_spin_threshold() * SPIN_THRESHOLD_DECAY;
+    double wanted = overshoot * 1.25;
+    if (wanted > threshold) {
+        threshold = wanted;
+    }
+    
+    if (threshold < SPIN_THRESHOLD_MIN) threshold = SPIN_THRESHOLD_MIN;
+    if (threshold > SPIN_THRESHOLD_MAX) threshold = SPIN_THRESHOLD_MAX;
+    atomic_store_i32(&g_spin_threshold_us, (int32_t)(threshold * 1000000.0 + 0.5));
+}
+
+void wait_until(double target_time) {
+    double now = get_current_time();
+    
+    // Sleep in short slices while the target is beyond the spin window
+    double spin_threshold = get_spin_threshold();
+    while (target_time - now > spin_threshold) {
+        double slice = target_time - now - spin_threshold;
+        sleep_seconds(slice);
+        double woke = get_current_time();
+        record_sleep_overshoot(woke - now - slice);
+        spin_threshold = get_spin_threshold();
+        now = woke;
+    }
+    
+    // Spin the rest for sub-millisecond accuracy
+    while (now < target_time) {
+        now = get_current_time();
+    }
+}
+
+double get_spin_threshold() {
+    return atomic_load_i32(&g_spin_threshold_us) / 1000000.0;
+}
+
+void init_timer() {
+#ifdef _WIN32
+    // Default Windows timer resolution is 15.6 ms, far too coarse for pacing
+    g_timer_period_set = timeBeginPeriod(1) == TIMERR_NOERROR;
+#endif
+
+    // Measure how late 1 ms sleeps wake up on this machine
+    atomic_store_i32(&g_spin_threshold_us, (int32_t)(SPIN_THRESHOLD_MIN * 1000000.0));
+    for (int i = 0; i < CALIBRATION_SLEEPS; i++) {
+        double start = get_current_time();
+        sleep_seconds(0.001);
+        record_sleep_overshoot(get_current_time() - start - 0.001);
+    }
+    
+    printf("Timer initialized - spin threshold: %.3fms\n", get_spin_threshold() * 1000.0);
+}
+
+void cleanup_timer() {
+#ifdef _WIN32
+    if (g_timer_period_set) {
+        timeEndPeriod(1);
+        g_timer_period_set = 0;
+    }
+#endif
+}
@@ -0,0 +1,17 @@
+#ifndef TIMER_H
+#define TIMER_H
+
+// Cross-platform time functions
+void init_timer();    // Raises the OS timer resolution and calibrates wait_until()
+void cleanup_timer();
+
+double get_current_time(); // Monotonic seconds from an arbitrary starting point
+void sleep_ms(int milliseconds);
+
+// Block until get_current_time() reaches target_time. Sleeps while far
+// from the target, then spins the last stretch, which is sized from the
+// measured sleep overshoot.
+void wait_until(double target_time);
+double get_spin_threshold();
+
+#endif // TIMER_H
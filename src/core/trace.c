@@ -0,0 +1,234 @@
+#include "trace.h"
+#include "atomics.h"
+#include "timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#define TRACE_THREAD_LOCAL __declspec(thread)
+#else
+#define TRACE_THREAD_LOCAL _Thread_local
+#endif
+
+#define TRACE_MAX_THREADS 64
+#define TRACE_EVENTS_PER_THREAD (1 << 17) // ~3 MB per thread that records
+#define TRACE_PATH_LENGTH 260
+#define TRACE_NAME_LENGTH 32
+
+typedef struct {
+    const char* name;   // NULL for end events
+    double timestamp;
+} TraceEvent;
+
+// Written only by its owning thread while a capture runs
+typedef struct {
+    TraceEvent* events;
+    int count;
+    int dropped;
+    char thread_name[TRACE_NAME_LENGTH];
+} TraceBuffer;
+
+typedef struct {
+    volatile int32_t recording;
+    volatile int32_t lock;          // Guards buffer registration
+    volatile int32_t generation;    // Bumped by cleanup_trace() to retire buffers
+    int buffer_count;
+    TraceBuffer buffers[TRACE_MAX_THREADS];
+    double start_time;
+    char path[TRACE_PATH_LENGTH];
+} TraceState;
+
+static TraceState g_trace;
+static volatile int32_t g_toggle_requested;
+
+static TRACE_THREAD_LOCAL TraceBuffer* t_buffer;
+static TRACE_THREAD_LOCAL int32_t t_generation;
+static TRACE_THREAD_LOCAL char t_pending_name[TRACE_NAME_LENGTH];
+
+static void trace_lock() {
+    while (!atomic_cas_i32(&g_trace.lock, 0, 1)) {
+        // Registration happens once per thread, contention is rare
+    }
+}
+
+static void trace_unlock() {
+    atomic_store_i32(&g_trace.lock, 0);
+}
+
+// First event on a thread claims a buffer
+static TraceBuffer* acquire_thread_buffer() {
+    int32_t generation = atomic_load_i32(&g_trace.generation);
+    if (t_buffer && t_generation == generation) {
+        return t_buffer;
+    }
+    
+    t_buffer = NULL;
+    trace_lock();
+    if (g_trace.buffer_count < TRACE_MAX_THREADS) {
+        TraceBuffer* buffer = &g_trace.buffers[g_trace.buffer_count];
+        buffer->events = (TraceEvent*)malloc(sizeof(TraceEvent) * TRACE_EVENTS_PER_THREAD);
+        if (buffer->events) {
+            buffer->count = 0;
+            buffer->dropped = 0;
+            if (t_pending_name[0]) {
+                memcpy(buffer->thread_name, t_pending_name, TRACE_NAME_LENGTH);
+            } else {
+                snprintf(buffer->thread_name, TRACE_NAME_LENGTH, "thread %d", g_trace.buffer_count);
+            }
+            g_trace.buffer_count++;
+            t_buffer = buffer;
+        }
+    }
+    trace_unlock();
+    
+    t_generation = generation;
+    return t_buffer;
+}
+
+static void record_event(const char* name) {
+    TraceBuffer* buffer = acquire_thread_buffer();
+    if (!buffer) {
+        return;
+    }
+    
+    if (buffer->count >= TRACE_EVENTS_PER_THREAD) {
+        buffer->dropped++;
+        return;
+    }
+    
+    TraceEvent* event = &buffer->events[buffer->count++];
+    event->name = name;
+    event->timestamp = get_current_time();
+}
+
+void trace_begin(const char* name) {
+    if (atomic_load_i32(&g_trace.recording)) {
+        record_event(name);
+    }
+}
+
+void trace_end() {
+    if (atomic_load_i32(&g_trace.recording)) {
+        record_event(NULL);
+    }
+}
+
+void trace_set_thread_name(const char* name) {
+    snprintf(t_pending_name, TRACE_NAME_LENGTH, "%s", name);
+    if (t_buffer && t_generation == atomic_load_i32(&g_trace.generation)) {
+        memcpy(t_buffer->thread_name, t_pending_name, TRACE_NAME_LENGTH);
+    }
+}
+
+static void write_trace_file() {
+    FILE* file = fopen(g_trace.path, "w");
+    if (!file) {
+        printf("Trace: cannot open %s for writing\n", g_trace.path);
+        return;
+    }
+    
+    long event_count = 0;
+    int dropped = 0;
+    int first = 1;
+    
+    fprintf(file, "{\"traceEvents\":[\n");
+    for (int t = 0; t < g_trace.buffer_count; t++) {
+        const TraceBuffer* buffer = &g_trace.buffers[t];
+        
+        fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                first ? "" : ",\n", t, buffer->thread_name);
+        first = 0;
+        
+        for (int i = 0; i < buffer->count; i++) {
+            const TraceEvent* event = &buffer->events[i];
+            double microseconds = (event->timestamp - g_trace.start_time) * 1000000.0;
+            if (event->name) {
+                fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"B\",\"ts\":%.3f,\"pid\":1,\"tid\":%d}",
+                        event->name, microseconds, t);
+            } else {
+                fprintf(file, ",\n{\"ph\":\"E\",\"ts\":%.3f,\"pid\":1,\"tid\":%d}", microseconds, t);
+            }
+        }
+        
+        event_count += buffer->count;
+        dropped += buffer->dropped;
+    }
+    fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    fclose(file);
+    
+    printf("Trace: wrote %ld events to %s", event_count, g_trace.path);
+    if (dropped > 0) {
+        printf(" (%d dropped, buffers full)", dropped);
+    }
+    printf("\n");
+}
+
+void init_trace() {
+    // Keep the generation moving so buffers from an earlier run are never reused
+    int32_t generation = atomic_load_i32(&g_trace.generation);
+    memset(&g_trace, 0, sizeof(TraceState));
+    atomic_store_i32(&g_trace.generation, generation + 1);
+    
+    trace_set_thread_name("main");
+}
+
+void trace_start(const char* path) {
+#ifndef SIMPLE_SHOOTER_TRACING
+    printf("Trace: markers are compiled out, the capture will be empty "
+           "(configure with SIMPLE_SHOOTER_ENABLE_TRACING=ON)\n");
+#endif
+    if (g_trace.recording) {
+        trace_stop();
+    }
+    
+    snprintf(g_trace.path, TRACE_PATH_LENGTH, "%s", path);
+    for (int t = 0; t < g_trace.buffer_count; t++) {
+        g_trace.buffers[t].count = 0;
+        g_trace.buffers[t].dropped = 0;
+    }
+    g_trace.start_time = get_current_time();
+    atomic_store_i32(&g_trace.recording, 1);
+    
+    printf("Trace: capture started, writing to %s\n", g_trace.path);
+}
+
+void trace_stop() {
+    if (!g_trace.recording) {
+        return;
+    }
+    
+    atomic_store_i32(&g_trace.recording, 0);
+    write_trace_file();
+}
+
+int trace_is_recording() {
+    return g_trace.recording;
+}
+
+void trace_request_toggle() {
+    atomic_store_i32(&g_toggle_requested, 1);
+}
+
+int trace_take_request() {
+    return atomic_exchange_i32(&g_toggle_requested, 0);
+}
+
+void trace_toggle(const char* path) {
+    if (g_trace.recording) {
+        trace_stop();
+    } else {
+        trace_start(path);
+    }
+}
+
+void cleanup_trace() {
+    trace_stop();
+    
+    for (int t = 0; t < g_trace.buffer_count; t++) {
+        free(g_trace.buffers[t].events);
+        g_trace.buffers[t].events = NULL;
+    }
+    g_trace.buffer_count = 0;
+    atomic_add_i32(&g_trace.generation, 1);
+}
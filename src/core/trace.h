@@ -0,0 +1,71 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Scoped timing markers recorded into per-thread buffers and written out in
+// Chrome trace JSON (chrome://tracing, ui.perfetto.dev). Markers compile to
+// nothing unless SIMPLE_SHOOTER_TRACING is defined, and cost one flag check
+// while no capture is running.
+
+// Capture file used by the in-game toggle key
+#define DEFAULT_TRACE_FILE "trace.json"
+
+void init_trace();
+void cleanup_trace(); // Writes the running capture, if any
+
+// Start a capture that is written to path by trace_stop() or cleanup_trace().
+// Call both between frames, while no jobs are running.
+void trace_start(const char* path);
+void trace_stop();
+int trace_is_recording();
+
+// Toggle from any thread (the in-game key is read by the simulation). The
+// main loop takes the request between frames with trace_take_request() and
+// applies it with trace_toggle().
+void trace_request_toggle();
+int trace_take_request();
+void trace_toggle(const char* path);
+
+// Label the calling thread in the trace viewer
+void trace_set_thread_name(const char* name);
+
+// Markers. name must be a string literal; ends close the innermost begin.
+void trace_begin(const char* name);
+void trace_end();
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef SIMPLE_SHOOTER_TRACING
+#define TRACE_BEGIN(name) trace_begin(name)
+#define TRACE_END() trace_end()
+#else
+#define TRACE_BEGIN(name) ((void)0)
+#define TRACE_END() ((void)0)
+#endif
+
+#ifdef __cplusplus
+// RAII marker for C++ scopes
+class TraceScope {
+public:
+    explicit TraceScope(const char* name) { trace_begin(name); }
+    ~TraceScope() { trace_end(); }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#ifdef SIMPLE_SHOOTER_TRACING
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(trace_scope_, __LINE__)(name)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#endif
+#endif
+
+#endif // TRACE_H
@@ -0,0 +1,161 @@
+#include "frustum.hpp"
+#include "renderer.hpp"
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define FRUSTUM_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FRUSTUM_SSE 1
+#endif
+
+Frustum extract_frustum(const Matrix4& view_projection) {
+    // Row i of the column-major matrix is (m[i], m[4 + i], m[8 + i], m[12 + i]).
+    // Each plane is the last row plus or minus one of the others.
+    const float* m = view_projection.data;
+    Frustum frustum;
+    
+    for (int i = 0; i < 6; i++) {
+        int row = i / 2;
+        float sign = (i % 2 == 0) ? 1.0f : -1.0f;
+        float* plane = frustum.planes[i];
+        
+        for (int k = 0; k < 4; k++) {
+            plane[k] = m[k * 4 + 3] + sign * m[k * 4 + row];
+        }
+        
+        float length = sqrtf(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+        if (length > 0.0f) {
+            for (int k = 0; k < 4; k++) {
+                plane[k] /= length;
+            }
+        }
+    }
+    
+    return frustum;
+}
+
+bool sphere_batch_begin(SphereBatch& batch, int capacity, Arena* arena) {
+    batch.count = 0;
+    batch.capacity = 0;
+    if (capacity <= 0) {
+        return true;
+    }
+    
+    size_t float_bytes = capacity * sizeof(float);
+    batch.x = static_cast<float*>(arena_alloc(arena, float_bytes, 32));
+    batch.y = static_cast<float*>(arena_alloc(arena, float_bytes, 32));
+    batch.z = static_cast<float*>(arena_alloc(arena, float_bytes, 32));
+    batch.radius = static_cast<float*>(arena_alloc(arena, float_bytes, 32));
+    batch.ids = static_cast<int*>(arena_alloc(arena, capacity * sizeof(int), 32));
+    if (!batch.x || !batch.y || !batch.z || !batch.radius || !batch.ids) {
+        return false;
+    }
+    
+    batch.capacity = capacity;
+    return true;
+}
+
+void sphere_batch_add(SphereBatch& batch, const Vector3& center, float radius, int id) {
+    if (batch.count >= batch.capacity) {
+        return;
+    }
+    
+    int i = batch.count++;
+    batch.x[i] = center.x;
+    batch.y[i] = center.y;
+    batch.z[i] = center.z;
+    batch.radius[i] = radius;
+    batch.ids[i] = id;
+}
+
+// Move sphere from to slot to, from >= to
+static inline void keep_sphere(SphereBatch& batch, int from, int to) {
+    batch.x[to] = batch.x[from];
+    batch.y[to] = batch.y[from];
+    batch.z[to] = batch.z[from];
+    batch.radius[to] = batch.radius[from];
+    batch.ids[to] = batch.ids[from];
+}
+
+static inline bool sphere_visible(const Frustum& frustum, float x, float y, float z, float radius) {
+    for (int p = 0; p < 6; p++) {
+        const float* plane = frustum.planes[p];
+        if (plane[0] * x + plane[1] * y + plane[2] * z + plane[3] < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void cull_sphere_batch(SphereBatch& batch, const Frustum& frustum, CullingStats& stats) {
+    int count = batch.count;
+    int kept = 0;
+    int i = 0;
+
+#if defined(FRUSTUM_AVX)
+    // Eight spheres against all six planes, then compact by the lane mask
+    for (; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_loadu_ps(batch.x + i);
+        __m256 y = _mm256_loadu_ps(batch.y + i);
+        __m256 z = _mm256_loadu_ps(batch.z + i);
+        __m256 neg_radius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(batch.radius + i));
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        
+        for (int p = 0; p < 6; p++) {
+            const float* plane = frustum.planes[p];
+            __m256 distance = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane[0]), x),
+                              _mm256_mul_ps(_mm256_set1_ps(plane[1]), y)),
+                _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane[2]), z),
+                              _mm256_set1_ps(plane[3])));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, neg_radius, _CMP_GE_OQ));
+        }
+        
+        int mask = _mm256_movemask_ps(inside);
+        for (int lane = 0; lane < 8; lane++) {
+            if (mask & (1 << lane)) {
+                keep_sphere(batch, i + lane, kept++);
+            }
+        }
+    }
+#elif defined(FRUSTUM_SSE)
+    // Four spheres against all six planes, then compact by the lane mask
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(batch.x + i);
+        __m128 y = _mm_loadu_ps(batch.y + i);
+        __m128 z = _mm_loadu_ps(batch.z + i);
+        __m128 neg_radius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(batch.radius + i));
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        
+        for (int p = 0; p < 6; p++) {
+            const float* plane = frustum.planes[p];
+            __m128 distance = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane[0]), x),
+                           _mm_mul_ps(_mm_set1_ps(plane[1]), y)),
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane[2]), z),
+                           _mm_set1_ps(plane[3])));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, neg_radius));
+        }
+        
+        int mask = _mm_movemask_ps(inside);
+        for (int lane = 0; lane < 4; lane++) {
+            if (mask & (1 << lane)) {
+                keep_sphere(batch, i + lane, kept++);
+            }
+        }
+    }
+#endif
+
+    // Scalar tail (and the whole batch without SIMD)
+    for (; i < count; i++) {
+        if (sphere_visible(frustum, batch.x[i], batch.y[i], batch.z[i], batch.radius[i])) {
+            keep_sphere(batch, i, kept++);
+        }
+    }
+    
+    batch.count = kept;
+    stats.visible += kept;
+    stats.culled += count - kept;
+}
@@ -0,0 +1,46 @@
+#ifndef FRUSTUM_HPP
+#define FRUSTUM_HPP
+
+#include "game_api.h"
+#include "../core/arena.h"
+
+// Forward declaration
+struct Matrix4;
+
+// View frustum as six planes (left, right, bottom, top, near, far) with
+// normalized inward normals, so each plane gives a signed distance
+struct Frustum {
+    float planes[6][4];
+};
+
+// Planes of the clip space volume of view_projection, the column-major
+// projection * view product
+Frustum extract_frustum(const Matrix4& view_projection);
+
+// Bounding spheres in parallel arrays for the batch test. ids carries
+// the caller's index for each sphere through culling.
+struct SphereBatch {
+    float* x;
+    float* y;
+    float* z;
+    float* radius;
+    int* ids;
+    int count;
+    int capacity;
+};
+
+// Visible and culled objects, summed over every batch of a frame
+struct CullingStats {
+    int visible;
+    int culled;
+};
+
+// Arrays are carved from arena (the frame arena while rendering)
+bool sphere_batch_begin(SphereBatch& batch, int capacity, Arena* arena);
+void sphere_batch_add(SphereBatch& batch, const Vector3& center, float radius, int id);
+
+// Drop the spheres entirely outside the frustum, compacting the batch in
+// place and keeping the order. Uses AVX or SSE when available.
+void cull_sphere_batch(SphereBatch& batch, const Frustum& frustum, CullingStats& stats);
+
+#endif // FRUSTUM_HPP
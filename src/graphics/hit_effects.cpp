@@ -1,4 +1,8 @@
 #include "hit_effects.hpp"
+#include "../core/job_system.h"
+#include "../core/rng.h"
+#include "../core/arena.h"
+#include "../core/log.h"
 #include <GL/glew.h>
 #include <iostream>
 #include <cmath>
@@ -48,6 +52,8 @@ bool HitEffectsSystem::initialize() {
     
     glBindVertexArray(0);
     
+    effects.reserve(MAX_HIT_EFFECTS);
+    
     std::cout << "Hit effects system initialized" << std::endl;
     return true;
 }
@@ -65,62 +71,75 @@ void HitEffectsSystem::cleanup() {
     effects.clear();
 }
 
+void HitEffectsSystem::add_effect(const HitEffect& effect) {
+    if (effects.size() < MAX_HIT_EFFECTS) {
+        effects.push_back(effect);
+    }
+}
+
 void HitEffectsSystem::create_explosion_effect(Vector3 position, float size) {
+    Rng* rng = rng_stream(RNG_STREAM_VFX);
+    
     // Create multiple particles for explosion effect
     for (int i = 0; i < 8; i++) {
         HitEffect effect;
         effect.position = position;
-        effect.position.x += ((float)rand() / RAND_MAX - 0.5f) * size;
-        effect.position.y += ((float)rand() / RAND_MAX - 0.5f) * size;
-        effect.position.z += ((float)rand() / RAND_MAX - 0.5f) * size;
+        effect.position.x += rng_range(rng, -0.5f, 0.5f) * size;
+        effect.position.y += rng_range(rng, -0.5f, 0.5f) * size;
+        effect.position.z += rng_range(rng, -0.5f, 0.5f) * size;
         
-        effect.color = {1.0f, 0.5f + (float)rand() / RAND_MAX * 0.5f, 0.0f}; // Orange-red
-        effect.lifetime = 0.5f + (float)rand() / RAND_MAX * 0.3f;
+        effect.color = {1.0f, 0.5f + rng_float(rng) * 0.5f, 0.0f}; // Orange-red
+        effect.lifetime = 0.5f + rng_float(rng) * 0.3f;
         effect.max_lifetime = effect.lifetime;
-        effect.size = size * (0.5f + (float)rand() / RAND_MAX * 0.5f);
+        effect.size = size * (0.5f + rng_float(rng) * 0.5f);
         effect.type = 0; // explosion
         
-        effects.push_back(effect);
+        add_effect(effect);
     }
     
-    std::cout << "Created explosion effect at (" << position.x << ", " << position.y << ", " << position.z << ")" << std::endl;
+    LOG_DEBUG(LOG_CATEGORY_GRAPHICS, "Created explosion effect at (%.2f, %.2f, %.2f)",
+              position.x, position.y, position.z);
 }
 
 void HitEffectsSystem::create_blood_effect(Vector3 position, float size) {
+    Rng* rng = rng_stream(RNG_STREAM_VFX);
+    
     // Create blood splatter particles
     for (int i = 0; i < 5; i++) {
         HitEffect effect;
         effect.position = position;
-        effect.position.x += ((float)rand() / RAND_MAX - 0.5f) * size * 0.5f;
-        effect.position.y += ((float)rand() / RAND_MAX - 0.5f) * size * 0.5f;
-        effect.position.z += ((float)rand() / RAND_MAX - 0.5f) * size * 0.5f;
+        effect.position.x += rng_range(rng, -0.5f, 0.5f) * size * 0.5f;
+        effect.position.y += rng_range(rng, -0.5f, 0.5f) * size * 0.5f;
+        effect.position.z += rng_range(rng, -0.5f, 0.5f) * size * 0.5f;
         
         effect.color = {0.8f, 0.1f, 0.1f}; // Dark red
-        effect.lifetime = 1.0f + (float)rand() / RAND_MAX * 0.5f;
+        effect.lifetime = 1.0f + rng_float(rng) * 0.5f;
         effect.max_lifetime = effect.lifetime;
-        effect.size = size * (0.3f + (float)rand() / RAND_MAX * 0.4f);
+        effect.size = size * (0.3f + rng_float(rng) * 0.4f);
         effect.type = 1; // blood
         
-        effects.push_back(effect);
+        add_effect(effect);
     }
 }
 
 void HitEffectsSystem::create_spark_effect(Vector3 position, float size) {
+    Rng* rng = rng_stream(RNG_STREAM_VFX);
+    
     // Create spark particles
     for (int i = 0; i < 6; i++) {
         HitEffect effect;
         effect.position = position;
-        effect.position.x += ((float)rand() / RAND_MAX - 0.5f) * size * 0.3f;
-        effect.position.y += ((float)rand() / RAND_MAX - 0.5f) * size * 0.3f;
-        effect.position.z += ((float)rand() / RAND_MAX - 0.5f) * size * 0.3f;
+        effect.position.x += rng_range(rng, -0.5f, 0.5f) * size * 0.3f;
+        effect.position.y += rng_range(rng, -0.5f, 0.5f) * size * 0.3f;
+        effect.position.z += rng_range(rng, -0.5f, 0.5f) * size * 0.3f;
         
-        effect.color = {1.0f, 1.0f, 0.5f + (float)rand() / RAND_MAX * 0.5f}; // Yellow-white
-        effect.lifetime = 0.3f + (float)rand() / RAND_MAX * 0.2f;
+        effect.color = {1.0f, 1.0f, 0.5f + rng_float(rng) * 0.5f}; // Yellow-white
+        effect.lifetime = 0.3f + rng_float(rng) * 0.2f;
         effect.max_lifetime = effect.lifetime;
-        effect.size = size * (0.2f + (float)rand() / RAND_MAX * 0.3f);
+        effect.size = size * (0.2f + rng_float(rng) * 0.3f);
         effect.type = 2; // spark
         
-        effects.push_back(effect);
+        add_effect(effect);
     }
 }
 
@@ -143,73 +162,91 @@ void HitEffectsSystem::create_damage_number(Vector3 position, float damage) {
     effect.size = 0.5f + damage * 0.01f; // Size based on damage
     effect.type = 3; // damage number
     
-    effects.push_back(effect);
+    add_effect(effect);
 }
 
-void HitEffectsSystem::update(float delta_time) {
-    // Update all effects
-    for (auto it = effects.begin(); it != effects.end();) {
-        it->lifetime -= delta_time;
-        
-        // Move particles based on type
-        switch (it->type) {
-            case 0: // explosion
-                it->position.y += delta_time * 2.0f; // Rise up
-                break;
-            case 1: // blood
-                it->position.y -= delta_time * 1.0f; // Fall down
-                break;
-            case 2: // spark
-                it->position.y += delta_time * 3.0f; // Rise quickly
-                break;
-            case 3: // damage number
-                it->position.y += delta_time * 1.5f; // Float up
-                break;
-        }
-        
-        // Fade out over time
-        float fade_ratio = it->lifetime / it->max_lifetime;
-        it->color.x *= fade_ratio;
-        it->color.y *= fade_ratio;
-        it->color.z *= fade_ratio;
-        
-        // Remove expired effects
-        if (it->lifetime <= 0.0f) {
-            it = effects.erase(it);
-        } else {
-            ++it;
-        }
+// Advance one effect, runs on job system workers
+static void update_effect(HitEffect& effect, float delta_time) {
+    effect.lifetime -= delta_time;
+    
+    // Move particles based on type
+    switch (effect.type) {
+        case 0: // explosion
+            effect.position.y += delta_time * 2.0f; // Rise up
+            break;
+        case 1: // blood
+            effect.position.y -= delta_time * 1.0f; // Fall down
+            break;
+        case 2: // spark
+            effect.position.y += delta_time * 3.0f; // Rise quickly
+            break;
+        case 3: // damage number
+            effect.position.y += delta_time * 1.5f; // Float up
+            break;
     }
+    
+    // Fade out over time
+    float fade_ratio = effect.lifetime / effect.max_lifetime;
+    effect.color.x *= fade_ratio;
+    effect.color.y *= fade_ratio;
+    effect.color.z *= fade_ratio;
 }
 
-void HitEffectsSystem::render(unsigned int shader_program) {
+void HitEffectsSystem::update(float delta_time) {
+    struct UpdateJob {
+        HitEffect* effects;
+        float delta_time;
+    } job = {effects.data(), delta_time};
+    
+    // Effects are independent, so update them in parallel
+    job_system_parallel_for(static_cast<int>(effects.size()), 256,
+        [](void* user_data, int begin, int end, int) {
+            UpdateJob* job = static_cast<UpdateJob*>(user_data);
+            for (int i = begin; i < end; i++) {
+                update_effect(job->effects[i], job->delta_time);
+            }
+        }, &job);
+    
+    // Remove expired effects in one pass
+    effects.erase(std::remove_if(effects.begin(), effects.end(),
+                                 [](const HitEffect& effect) { return effect.lifetime <= 0.0f; }),
+                  effects.end());
+}
+
+void HitEffectsSystem::render(const ShaderProgram& shader, const Frustum& frustum, CullingStats& stats) {
     if (effects.empty() || !particle_vao) {
         return;
     }
     
-    // Enable blending for particle effects
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    // Cull particles in one batch, radius is the half diagonal of the quad
+    SphereBatch particles;
+    if (!sphere_batch_begin(particles, static_cast<int>(effects.size()), get_frame_arena())) {
+        return;
+    }
+    for (int i = 0; i < static_cast<int>(effects.size()); i++) {
+        sphere_batch_add(particles, effects[i].position, effects[i].size * 0.71f, i);
+    }
+    cull_sphere_batch(particles, frustum, stats);
     
+    // Blending is set by the render queue's material
     glBindVertexArray(particle_vao);
     
-    for (const auto& effect : effects) {
+    for (int i = 0; i < particles.count; i++) {
+        const HitEffect& effect = effects[particles.ids[i]];
+        
         // Set particle color
-        int color_loc = glGetUniformLocation(shader_program, "objectColor");
-        glUniform3f(color_loc, effect.color.x, effect.color.y, effect.color.z);
+        shader.set_vec3(UNIFORM_OBJECT_COLOR, effect.color.x, effect.color.y, effect.color.z);
         
         // Create model matrix for particle
         // This is a simplified version - in a real implementation you'd use proper matrix math
-        glUniform3f(glGetUniformLocation(shader_program, "particlePos"), 
-                   effect.position.x, effect.position.y, effect.position.z);
-        glUniform1f(glGetUniformLocation(shader_program, "particleSize"), effect.size);
+        shader.set_vec3(UNIFORM_PARTICLE_POSITION, effect.position.x, effect.position.y, effect.position.z);
+        shader.set_float(UNIFORM_PARTICLE_SIZE, effect.size);
         
         // Render particle
         glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
     }
     
     glBindVertexArray(0);
-    glDisable(GL_BLEND);
 }
 
 void HitEffectsSystem::clear_all_effects() {
@@ -1,9 +1,15 @@
 #ifndef HIT_EFFECTS_HPP
 #define HIT_EFFECTS_HPP
 
-#include "../game_api.h"
+#include "game_api.h"
+#include "shader_program.hpp"
+#include "frustum.hpp"
 #include <vector>
 
+// Live particles are capped so the effect list never grows past its
+// initial reservation; new particles are dropped while it is full
+#define MAX_HIT_EFFECTS 4096
+
 struct HitEffect {
     Vector3 position;
     Vector3 color;
@@ -18,6 +24,8 @@ private:
     std::vector<HitEffect> effects;
     unsigned int particle_vao, particle_vbo;
     
+    void add_effect(const HitEffect& effect);
+    
 public:
     HitEffectsSystem();
     ~HitEffectsSystem();
@@ -33,7 +41,8 @@ public:
     
     // Update and render
     void update(float delta_time);
-    void render(unsigned int shader_program);
+    // Particles outside the frustum are skipped and counted in stats
+    void render(const ShaderProgram& shader, const Frustum& frustum, CullingStats& stats);
     
     // Utility
     void clear_all_effects();
@@ -0,0 +1,112 @@
+#include "instance_batch.hpp"
+#include <iostream>
+#include <algorithm>
+
+// OpenGL headers
+#ifdef _WIN32
+#include <windows.h>
+#include <GL/gl.h>
+#else
+#ifdef __APPLE__
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#endif
+#endif
+
+InstanceData make_instance_data(const Vector3& position, float scale, const Vector3& color, float color_blend) {
+    InstanceData instance;
+    std::fill(instance.model, instance.model + 16, 0.0f);
+    instance.model[0] = scale;
+    instance.model[5] = scale;
+    instance.model[10] = scale;
+    instance.model[12] = position.x;
+    instance.model[13] = position.y;
+    instance.model[14] = position.z;
+    instance.model[15] = 1.0f;
+    
+    instance.color[0] = color.x;
+    instance.color[1] = color.y;
+    instance.color[2] = color.z;
+    instance.color[3] = color_blend;
+    return instance;
+}
+
+InstanceBatch::InstanceBatch() :
+    model(nullptr),
+    instance_vbo(0),
+    gpu_capacity(0) {
+}
+
+InstanceBatch::~InstanceBatch() {
+    cleanup();
+}
+
+bool InstanceBatch::initialize(const Model* model) {
+    if (!model || !model->is_initialized()) {
+        std::cerr << "Instance batch needs a loaded model" << std::endl;
+        return false;
+    }
+    this->model = model;
+    
+    glGenBuffers(1, &instance_vbo);
+    
+    // Point the model's VAO at the instance buffer, advancing once per instance
+    glBindVertexArray(model->get_vao());
+    glBindBuffer(GL_ARRAY_BUFFER, instance_vbo);
+    
+    int stride = sizeof(InstanceData);
+    for (int column = 0; column < 4; column++) {
+        unsigned int location = INSTANCE_ATTRIBUTE_MODEL + column;
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, stride,
+                              (void*)(offsetof(InstanceData, model) + column * 4 * sizeof(float)));
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+    
+    glVertexAttribPointer(INSTANCE_ATTRIBUTE_COLOR, 4, GL_FLOAT, GL_FALSE, stride,
+                          (void*)offsetof(InstanceData, color));
+    glEnableVertexAttribArray(INSTANCE_ATTRIBUTE_COLOR);
+    glVertexAttribDivisor(INSTANCE_ATTRIBUTE_COLOR, 1);
+    
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return true;
+}
+
+void InstanceBatch::cleanup() {
+    if (instance_vbo) glDeleteBuffers(1, &instance_vbo);
+    
+    instance_vbo = 0;
+    gpu_capacity = 0;
+    model = nullptr;
+}
+
+int InstanceBatch::draw(const InstanceData* instances, int count) {
+    if (!model || count <= 0) {
+        return 0;
+    }
+    
+    glBindBuffer(GL_ARRAY_BUFFER, instance_vbo);
+    
+    // Grow by doubling so the buffer settles within a few frames; otherwise
+    // orphan last frame's storage so the upload never waits on the GPU
+    if (count > gpu_capacity) {
+        gpu_capacity = std::max(count, gpu_capacity * 2);
+    }
+    glBufferData(GL_ARRAY_BUFFER, gpu_capacity * sizeof(InstanceData), NULL, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(InstanceData), instances);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    
+    model->render_instanced(count);
+    return 1;
+}
+
+void set_default_instance_attributes() {
+    for (int column = 0; column < 4; column++) {
+        glVertexAttrib4f(INSTANCE_ATTRIBUTE_MODEL + column,
+                         column == 0 ? 1.0f : 0.0f, column == 1 ? 1.0f : 0.0f,
+                         column == 2 ? 1.0f : 0.0f, column == 3 ? 1.0f : 0.0f);
+    }
+    glVertexAttrib4f(INSTANCE_ATTRIBUTE_COLOR, 1.0f, 1.0f, 1.0f, 0.0f);
+}
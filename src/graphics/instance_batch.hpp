@@ -0,0 +1,44 @@
+#ifndef INSTANCE_BATCH_HPP
+#define INSTANCE_BATCH_HPP
+
+#include "game_api.h"
+#include "model.hpp"
+
+// Per-instance vertex data. The mesh attributes use locations 0-3, the
+// model matrix takes 4-7 (one per column) and the color 8.
+struct InstanceData {
+    float model[16];    // Column-major, translation and uniform scale
+    float color[4];     // rgb, a blends from the mesh's vertex colors (0) to rgb (1)
+};
+
+#define INSTANCE_ATTRIBUTE_MODEL 4
+#define INSTANCE_ATTRIBUTE_COLOR 8
+
+// Fill one instance: translation times uniform scale, written out
+// instead of multiplied
+InstanceData make_instance_data(const Vector3& position, float scale, const Vector3& color, float color_blend);
+
+// Instances of one model drawn with one glDrawElementsInstanced. The
+// instances are streamed into a GPU buffer that only grows.
+class InstanceBatch {
+private:
+    const Model* model;
+    unsigned int instance_vbo;
+    int gpu_capacity;           // Instances the GPU buffer holds
+
+public:
+    InstanceBatch();
+    ~InstanceBatch();
+    
+    bool initialize(const Model* model);
+    void cleanup();
+    
+    // Upload instances and draw them, returns the draw calls issued
+    int draw(const InstanceData* instances, int count);
+};
+
+// Identity transform and plain vertex colors for draws without an
+// instance buffer (trails, particles) that share the instanced shader
+void set_default_instance_attributes();
+
+#endif // INSTANCE_BATCH_HPP
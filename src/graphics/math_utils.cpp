@@ -169,4 +169,12 @@ Matrix4 create_look_at_matrix(float eye_x, float eye_y, float eye_z,
     result.data[14] = -(-forward_x * eye_x + -forward_y * eye_y + -forward_z * eye_z);    // [3][2]
     
     return result;
-}
\ No newline at end of file
+}
+
+Vector3 interpolate_position(const Vector3& previous, const Vector3& current, float t) {
+    Vector3 result;
+    result.x = previous.x + (current.x - previous.x) * t;
+    result.y = previous.y + (current.y - previous.y) * t;
+    result.z = previous.z + (current.z - previous.z) * t;
+    return result;
+}
@@ -246,6 +246,16 @@ void Model::render() const {
     glBindVertexArray(0);
 }
 
+void Model::render_instanced(int instance_count) const {
+    if (!initialized || instance_count <= 0) {
+        return;
+    }
+    
+    glBindVertexArray(vao);
+    glDrawElementsInstanced(GL_TRIANGLES, index_count, GL_UNSIGNED_INT, 0, instance_count);
+    glBindVertexArray(0);
+}
+
 void Model::cleanup() {
     if (!initialized) {
         return;
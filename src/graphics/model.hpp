@@ -26,9 +26,11 @@ public:
     
     // Rendering
     void render() const;
+    void render_instanced(int instance_count) const;
     
     // Getters
     bool is_initialized() const { return initialized; }
+    unsigned int get_vao() const { return vao; }
     int get_vertex_count() const { return vertex_count; }
     int get_index_count() const { return index_count; }
 };
@@ -25,36 +25,63 @@ ProjectileTrail::~ProjectileTrail() {
 }
 
 void ProjectileTrail::initialize() {
-    trails.resize(MAX_PROJECTILES);
+    // Trails are sized to the projectile pool on the first update, since
+    // the capacity is only known once the game state is initialized
+    trail_points.clear();
+    trail_lengths.clear();
+    trail_generations.clear();
     std::cout << "Projectile Trail system initialized" << std::endl;
 }
 
 void ProjectileTrail::update(const GameState& game_state, float delta_time) {
+    const EntityPool& pool = game_state.projectile_pool;
+    
+    // Every slot gets room for a full trail up front, so updates never allocate
+    if (slot_count() != pool.capacity) {
+        trail_points.assign(static_cast<size_t>(pool.capacity) * MAX_TRAIL_POINTS, TrailPoint());
+        trail_lengths.assign(pool.capacity, 0);
+        trail_generations.assign(pool.capacity, 0);
+    }
+    
+    // Clear trails whose slot was released or handed to a new projectile
+    for (int i = 0; i < slot_count(); i++) {
+        if (pool.alive_index[i] < 0 || trail_generations[i] != pool.generations[i]) {
+            trail_lengths[i] = 0;
+            trail_generations[i] = pool.generations[i];
+        }
+    }
+    
     // Update existing trails
-    for (int i = 0; i < MAX_PROJECTILES; i++) {
-        auto& trail = trails[i];
+    for (int slot = 0; slot < slot_count(); slot++) {
+        TrailPoint* points = trail_begin(slot);
         
-        // Update trail points
-        for (auto it = trail.begin(); it != trail.end();) {
-            it->lifetime -= delta_time;
-            it->alpha = it->lifetime / trail_duration;
+        // Age trail points and compact out the expired ones
+        int kept = 0;
+        for (int i = 0; i < trail_lengths[slot]; i++) {
+            TrailPoint& point = points[i];
+            point.lifetime -= delta_time;
+            point.alpha = point.lifetime / trail_duration;
             
-            if (it->lifetime <= 0.0f) {
-                it = trail.erase(it);
-            } else {
-                ++it;
+            if (point.lifetime > 0.0f) {
+                points[kept++] = point;
             }
         }
+        trail_lengths[slot] = kept;
     }
     
     // Add new trail points for active projectiles
-    for (int i = 0; i < game_state.projectile_count; i++) {
-        const Projectile& projectile = game_state.projectiles[i];
+    for (int i = 0; i < pool.count; i++) {
+        int slot = pool.alive[i];
+        const Projectile& projectile = game_state.projectiles[slot];
+        
+        if (slot >= slot_count()) {
+            continue;
+        }
         
         // Add trail point if enough distance traveled
         bool should_add = true;
-        if (!trails[i].empty()) {
-            const TrailPoint& last_point = trails[i].back();
+        if (trail_lengths[slot] > 0) {
+            const TrailPoint& last_point = trail_begin(slot)[trail_lengths[slot] - 1];
             float dx = projectile.position.x - last_point.position.x;
             float dy = projectile.position.y - last_point.position.y;
             float dz = projectile.position.z - last_point.position.z;
@@ -64,32 +91,27 @@ void ProjectileTrail::update(const GameState& game_state, float delta_time) {
         }
         
         if (should_add) {
-            add_trail_point(i, projectile.position);
-        }
-    }
-    
-    // Clear trails for removed projectiles
-    for (int i = game_state.projectile_count; i < MAX_PROJECTILES; i++) {
-        if (!trails[i].empty()) {
-            trails[i].clear();
+            add_trail_point(slot, projectile.position);
         }
     }
 }
 
-void ProjectileTrail::render(unsigned int shader_program) {
-    // Disable depth writing for transparent trails
-    glDepthMask(GL_FALSE);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+void ProjectileTrail::render(const ShaderProgram& shader) {
+    // Blending and depth writes are set by the render queue's material
     
     // Render each trail
-    for (const auto& trail : trails) {
-        if (trail.size() < 2) continue;
+    for (int slot = 0; slot < slot_count(); slot++) {
+        int length = trail_lengths[slot];
+        if (length < 2) continue;
+        
+        const TrailPoint* points = trail_begin(slot);
         
         // Render trail as line strip
         glBegin(GL_LINE_STRIP);
         
-        for (const auto& point : trail) {
+        for (int i = 0; i < length; i++) {
+            const TrailPoint& point = points[i];
+            
             // Color based on alpha (fade out)
             float r = 1.0f;
             float g = 0.5f;
@@ -102,14 +124,10 @@ void ProjectileTrail::render(unsigned int shader_program) {
         
         glEnd();
     }
-    
-    // Re-enable depth writing
-    glDepthMask(GL_TRUE);
-    glDisable(GL_BLEND);
 }
 
-void ProjectileTrail::add_trail_point(int projectile_id, const Vector3& position) {
-    if (projectile_id < 0 || projectile_id >= MAX_PROJECTILES) {
+void ProjectileTrail::add_trail_point(int slot, const Vector3& position) {
+    if (slot < 0 || slot >= slot_count()) {
         return;
     }
     
@@ -118,28 +136,27 @@ void ProjectileTrail::add_trail_point(int projectile_id, const Vector3& position
     point.lifetime = trail_duration;
     point.alpha = 1.0f;
     
-    trails[projectile_id].push_back(point);
-    
-    // Limit trail length
-    const size_t max_trail_points = 20;
-    if (trails[projectile_id].size() > max_trail_points) {
-        trails[projectile_id].erase(trails[projectile_id].begin());
+    // Limit trail length, a full trail drops its oldest point
+    TrailPoint* points = trail_begin(slot);
+    int& length = trail_lengths[slot];
+    if (length == MAX_TRAIL_POINTS) {
+        std::copy(points + 1, points + length, points);
+        length--;
     }
+    points[length++] = point;
 }
 
-void ProjectileTrail::clear_trail(int projectile_id) {
-    if (projectile_id >= 0 && projectile_id < MAX_PROJECTILES) {
-        trails[projectile_id].clear();
+void ProjectileTrail::clear_trail(int slot) {
+    if (slot >= 0 && slot < slot_count()) {
+        trail_lengths[slot] = 0;
     }
 }
 
 void ProjectileTrail::clear_all_trails() {
-    for (auto& trail : trails) {
-        trail.clear();
-    }
+    std::fill(trail_lengths.begin(), trail_lengths.end(), 0);
 }
 
 void ProjectileTrail::cleanup() {
     clear_all_trails();
     std::cout << "Projectile Trail system cleaned up" << std::endl;
-}
+}
\ No newline at end of file
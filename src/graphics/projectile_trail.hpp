@@ -1,7 +1,9 @@
 #ifndef PROJECTILE_TRAIL_HPP
 #define PROJECTILE_TRAIL_HPP
 
-#include "../game_api.h"
+#include "game_api.h"
+#include "shader_program.hpp"
+#include <cstddef>
 #include <vector>
 
 // Trail point structure
@@ -11,25 +13,33 @@ struct TrailPoint {
     float alpha;
 };
 
+// Points kept per trail, oldest first
+#define MAX_TRAIL_POINTS 20
+
 // Projectile trail system
 class ProjectileTrail {
 private:
-    std::vector<std::vector<TrailPoint>> trails; // One trail per projectile
+    std::vector<TrailPoint> trail_points;   // MAX_TRAIL_POINTS per projectile slot
+    std::vector<int> trail_lengths;         // Points in use per slot
+    std::vector<int> trail_generations;     // Slot generation that owns each trail
     float trail_duration;
     float trail_spacing;
     
+    int slot_count() const { return static_cast<int>(trail_lengths.size()); }
+    TrailPoint* trail_begin(int slot) { return &trail_points[static_cast<size_t>(slot) * MAX_TRAIL_POINTS]; }
+    
 public:
     ProjectileTrail();
     ~ProjectileTrail();
     
     void initialize();
     void update(const GameState& game_state, float delta_time);
-    void render(unsigned int shader_program);
+    void render(const ShaderProgram& shader);
     void cleanup();
     
-    // Trail management
-    void add_trail_point(int projectile_id, const Vector3& position);
-    void clear_trail(int projectile_id);
+    // Trail management (indexed by projectile pool slot)
+    void add_trail_point(int slot, const Vector3& position);
+    void clear_trail(int slot);
     void clear_all_trails();
 };
 
@@ -0,0 +1,200 @@
+#include "render_queue.hpp"
+#include <cstring>
+#include <algorithm>
+
+// OpenGL headers
+#ifdef _WIN32
+#include <windows.h>
+#include <GL/gl.h>
+#else
+#ifdef __APPLE__
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#endif
+#endif
+
+// Blend and depth write per RenderMaterial
+static const struct {
+    bool blend;
+    bool depth_write;
+} material_states[RENDER_MATERIAL_COUNT] = {
+    {false, true},      // RENDER_MATERIAL_OPAQUE
+    {true, false}       // RENDER_MATERIAL_ALPHA_BLEND
+};
+
+uint64_t make_render_key(RenderPass pass, RenderShader shader, RenderMesh mesh, RenderMaterial material,
+                         float depth) {
+    // Quantize the camera distance; transparent commands sort back to front
+    float normalized = std::min(std::max(depth / RENDER_QUEUE_MAX_DEPTH, 0.0f), 1.0f);
+    uint32_t depth_bits = static_cast<uint32_t>(normalized * 4294967295.0);
+    if (pass == RENDER_PASS_TRANSPARENT) {
+        depth_bits = ~depth_bits;
+    }
+    
+    return (static_cast<uint64_t>(pass) << RENDER_KEY_PASS_SHIFT) |
+           (static_cast<uint64_t>(shader) << RENDER_KEY_SHADER_SHIFT) |
+           (static_cast<uint64_t>(mesh) << RENDER_KEY_MESH_SHIFT) |
+           (static_cast<uint64_t>(material) << RENDER_KEY_MATERIAL_SHIFT) |
+           depth_bits;
+}
+
+RenderQueue::RenderQueue() :
+    commands(nullptr),
+    sort_scratch(nullptr),
+    instances(nullptr),
+    run_instances(nullptr),
+    command_count(0),
+    capacity(0),
+    stats() {
+    for (int i = 0; i < RENDER_SHADER_COUNT; i++) {
+        shaders[i] = nullptr;
+    }
+    for (int i = 0; i < RENDER_MESH_COUNT; i++) {
+        draw_funcs[i] = nullptr;
+        draw_user_data[i] = nullptr;
+    }
+}
+
+void RenderQueue::register_shader(RenderShader shader, const ShaderProgram* program) {
+    shaders[shader] = program;
+}
+
+void RenderQueue::register_mesh(RenderMesh mesh, RenderDrawFunc draw, void* user_data) {
+    draw_funcs[mesh] = draw;
+    draw_user_data[mesh] = user_data;
+}
+
+bool RenderQueue::begin(int max_commands, Arena* arena) {
+    command_count = 0;
+    capacity = 0;
+    stats = RenderQueueStats();
+    if (max_commands <= 0) {
+        return true;
+    }
+    
+    commands = static_cast<RenderCommand*>(arena_alloc(arena, max_commands * sizeof(RenderCommand),
+                                                       alignof(RenderCommand)));
+    sort_scratch = static_cast<RenderCommand*>(arena_alloc(arena, max_commands * sizeof(RenderCommand),
+                                                           alignof(RenderCommand)));
+    instances = static_cast<InstanceData*>(arena_alloc(arena, max_commands * sizeof(InstanceData),
+                                                       alignof(InstanceData)));
+    run_instances = static_cast<InstanceData*>(arena_alloc(arena, max_commands * sizeof(InstanceData),
+                                                           alignof(InstanceData)));
+    if (!commands || !sort_scratch || !instances || !run_instances) {
+        return false;
+    }
+    
+    capacity = max_commands;
+    return true;
+}
+
+void RenderQueue::push(RenderPass pass, RenderShader shader, RenderMesh mesh, RenderMaterial material,
+                       float depth, const InstanceData* instance) {
+    if (command_count >= capacity) {
+        return;
+    }
+    
+    int index = command_count++;
+    RenderCommand& command = commands[index];
+    command.key = make_render_key(pass, shader, mesh, material, depth);
+    command.instance = static_cast<uint32_t>(index);
+    command.padding = 0;
+    if (instance) {
+        instances[index] = *instance;
+    }
+}
+
+void RenderQueue::sort() {
+    // LSD radix sort, 8 bits per pass. A pass where every key has the same
+    // byte (the unused bits, usually the shader) is skipped.
+    if (command_count < 2) {
+        return;
+    }
+    
+    RenderCommand* source = commands;
+    RenderCommand* destination = sort_scratch;
+    
+    for (int shift = 0; shift < 64; shift += 8) {
+        int counts[256] = {0};
+        for (int i = 0; i < command_count; i++) {
+            counts[(source[i].key >> shift) & 0xFF]++;
+        }
+        if (counts[(source[0].key >> shift) & 0xFF] == command_count) {
+            continue;
+        }
+        
+        int offset = 0;
+        for (int bucket = 0; bucket < 256; bucket++) {
+            int count = counts[bucket];
+            counts[bucket] = offset;
+            offset += count;
+        }
+        for (int i = 0; i < command_count; i++) {
+            destination[counts[(source[i].key >> shift) & 0xFF]++] = source[i];
+        }
+        std::swap(source, destination);
+    }
+    
+    if (source != commands) {
+        memcpy(commands, source, command_count * sizeof(RenderCommand));
+    }
+}
+
+void RenderQueue::apply_material(RenderMaterial material) {
+    if (material_states[material].blend) {
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    } else {
+        glDisable(GL_BLEND);
+    }
+    glDepthMask(material_states[material].depth_write ? GL_TRUE : GL_FALSE);
+}
+
+void RenderQueue::submit() {
+    stats.commands = command_count;
+    int current_shader = -1;
+    int current_material = -1;
+    
+    int run_start = 0;
+    while (run_start < command_count) {
+        // A run is every following command with the same state bits
+        uint64_t state = commands[run_start].key & RENDER_KEY_STATE_MASK;
+        int run_end = run_start + 1;
+        while (run_end < command_count && (commands[run_end].key & RENDER_KEY_STATE_MASK) == state) {
+            run_end++;
+        }
+        
+        int shader = static_cast<int>((state >> RENDER_KEY_SHADER_SHIFT) & 0xFF);
+        int mesh = static_cast<int>((state >> RENDER_KEY_MESH_SHIFT) & 0xFF);
+        int material = static_cast<int>((state >> RENDER_KEY_MATERIAL_SHIFT) & 0xFF);
+        
+        // Only touch GL state that differs from the previous run
+        if (shader != current_shader && shaders[shader]) {
+            shaders[shader]->use();
+            current_shader = shader;
+            stats.state_changes++;
+        }
+        if (material != current_material) {
+            apply_material(static_cast<RenderMaterial>(material));
+            current_material = material;
+            stats.state_changes++;
+        }
+        
+        // Gather the run's instances in sorted order
+        int count = run_end - run_start;
+        for (int i = 0; i < count; i++) {
+            run_instances[i] = instances[commands[run_start + i].instance];
+        }
+        
+        if (draw_funcs[mesh]) {
+            stats.draw_calls += draw_funcs[mesh](draw_user_data[mesh], run_instances, count);
+        }
+        run_start = run_end;
+    }
+    
+    // Leave the default state for whatever draws next (UI)
+    if (current_material != -1 && current_material != RENDER_MATERIAL_OPAQUE) {
+        apply_material(RENDER_MATERIAL_OPAQUE);
+    }
+}
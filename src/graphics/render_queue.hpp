@@ -0,0 +1,110 @@
+#ifndef RENDER_QUEUE_HPP
+#define RENDER_QUEUE_HPP
+
+#include "instance_batch.hpp"
+#include "shader_program.hpp"
+#include "../core/arena.h"
+#include <cstdint>
+
+// Draw passes, submitted in this order
+enum RenderPass {
+    RENDER_PASS_OPAQUE,         // Front to back
+    RENDER_PASS_TRANSPARENT,    // Back to front
+    RENDER_PASS_COUNT
+};
+
+enum RenderShader {
+    RENDER_SHADER_LIT,
+    RENDER_SHADER_COUNT
+};
+
+// Meshes, in submission order within a pass. Trails and particles build
+// their own geometry and ignore instance data.
+enum RenderMesh {
+    RENDER_MESH_CUBE,
+    RENDER_MESH_SPHERE,
+    RENDER_MESH_PLANE,
+    RENDER_MESH_TRAILS,
+    RENDER_MESH_PARTICLES,
+    RENDER_MESH_COUNT
+};
+
+// Blend and depth state bundles
+enum RenderMaterial {
+    RENDER_MATERIAL_OPAQUE,         // No blending, depth writes
+    RENDER_MATERIAL_ALPHA_BLEND,    // Alpha blending, depth tested but not written
+    RENDER_MATERIAL_COUNT
+};
+
+// 64-bit sort key, most significant first:
+//   pass 4 | shader 8 | mesh 8 | material 8 | unused 4 | depth 32
+// Commands that differ only in depth share all state and draw as one batch.
+#define RENDER_KEY_PASS_SHIFT 60
+#define RENDER_KEY_SHADER_SHIFT 52
+#define RENDER_KEY_MESH_SHIFT 44
+#define RENDER_KEY_MATERIAL_SHIFT 36
+#define RENDER_KEY_STATE_MASK (~0xFFFFFFFFull)
+
+// Camera distance that maps to the largest depth value, farther clamps
+#define RENDER_QUEUE_MAX_DEPTH 1000.0f
+
+struct RenderCommand {
+    uint64_t key;
+    uint32_t instance;      // Index into the queue's instance data
+    uint32_t padding;
+};
+
+// Draw a run of commands sharing one mesh, instances in sorted order.
+// Returns the draw calls issued.
+typedef int (*RenderDrawFunc)(void* user_data, const InstanceData* instances, int count);
+
+struct RenderQueueStats {
+    int commands;
+    int draw_calls;
+    int state_changes;      // Shader and material switches actually applied
+};
+
+// Per-frame list of draw commands. The game-state walk pushes commands in
+// any order, sort() radix-sorts them by key, and submit() walks the sorted
+// list: each run of equal state becomes one draw and GL state is only
+// touched when it differs from the previous run. Commands and instance
+// data live in the frame arena, so filling the queue never touches GL and
+// can move to another thread.
+class RenderQueue {
+private:
+    RenderCommand* commands;
+    RenderCommand* sort_scratch;
+    InstanceData* instances;
+    InstanceData* run_instances;    // One run's instances gathered in sorted order
+    int command_count;
+    int capacity;
+    
+    const ShaderProgram* shaders[RENDER_SHADER_COUNT];
+    RenderDrawFunc draw_funcs[RENDER_MESH_COUNT];
+    void* draw_user_data[RENDER_MESH_COUNT];
+    
+    RenderQueueStats stats;
+    
+    void apply_material(RenderMaterial material);
+
+public:
+    RenderQueue();
+    
+    void register_shader(RenderShader shader, const ShaderProgram* program);
+    void register_mesh(RenderMesh mesh, RenderDrawFunc draw, void* user_data);
+    
+    // Start a frame with room for max_commands, extra commands are dropped
+    bool begin(int max_commands, Arena* arena);
+    void push(RenderPass pass, RenderShader shader, RenderMesh mesh, RenderMaterial material,
+              float depth, const InstanceData* instance = nullptr);
+    
+    void sort();
+    void submit();
+    
+    const RenderQueueStats& get_stats() const { return stats; }
+};
+
+uint64_t make_render_key(RenderPass pass, RenderShader shader, RenderMesh mesh, RenderMaterial material,
+                         float depth);
+
+#endif // RENDER_QUEUE_HPP
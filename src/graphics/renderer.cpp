@@ -4,10 +4,16 @@
 #include "renderer.hpp"
 #include "camera.hpp"
 #include "model.hpp"
+#include "frustum.hpp"
+#include "render_queue.hpp"
+#include "../core/arena.h"
+#include "../core/trace.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <vector>
+#include <algorithm>
+#include <cmath>
 
 // OpenGL headers
 #ifdef _WIN32
@@ -36,13 +42,18 @@ layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aColor;
 layout (location = 2) in vec3 aNormal;
 layout (location = 3) in vec2 aTexCoord;
+layout (location = 4) in mat4 aInstanceModel;
+layout (location = 8) in vec4 aInstanceColor;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-uniform vec3 lightPos;
-uniform vec3 lightColor;
-uniform vec3 viewPos;
+layout (std140) uniform FrameUniforms {
+    mat4 view;
+    mat4 projection;
+    vec4 lightPos;
+    vec4 lightColor;
+    vec4 viewPos;
+    float ambientStrength;
+    float specularStrength;
+};
 
 out vec3 vertexColor;
 out vec3 normal;
@@ -52,16 +63,18 @@ out vec3 lightDir;
 out vec3 viewDir;
 
 void main() {
-    vec4 worldPos = model * vec4(aPos, 1.0);
+    vec4 worldPos = aInstanceModel * vec4(aPos, 1.0);
     gl_Position = projection * view * worldPos;
     
-    vertexColor = aColor;
-    normal = mat3(transpose(inverse(model))) * aNormal;
+    vertexColor = mix(aColor, aInstanceColor.rgb, aInstanceColor.a);
+    // Instances only translate and scale uniformly, so the model matrix
+    // transforms normals directly (the fragment shader renormalizes)
+    normal = mat3(aInstanceModel) * aNormal;
     fragPos = vec3(worldPos);
     texCoord = aTexCoord;
     
-    lightDir = normalize(lightPos - fragPos);
-    viewDir = normalize(viewPos - fragPos);
+    lightDir = normalize(lightPos.xyz - fragPos);
+    viewDir = normalize(viewPos.xyz - fragPos);
 }
 )";
 
@@ -75,40 +88,70 @@ in vec2 texCoord;
 in vec3 lightDir;
 in vec3 viewDir;
 
-uniform vec3 lightColor;
-uniform float ambientStrength;
-uniform float specularStrength;
+layout (std140) uniform FrameUniforms {
+    mat4 view;
+    mat4 projection;
+    vec4 lightPos;
+    vec4 lightColor;
+    vec4 viewPos;
+    float ambientStrength;
+    float specularStrength;
+};
 
 out vec4 FragColor;
 
 void main() {
     // Ambient lighting
-    vec3 ambient = ambientStrength * lightColor;
+    vec3 ambient = ambientStrength * lightColor.rgb;
     
     // Diffuse lighting
     vec3 norm = normalize(normal);
     float diff = max(dot(norm, lightDir), 0.0);
-    vec3 diffuse = diff * lightColor;
+    vec3 diffuse = diff * lightColor.rgb;
     
     // Specular lighting
     vec3 reflectDir = reflect(-lightDir, norm);
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
-    vec3 specular = specularStrength * spec * lightColor;
+    vec3 specular = specularStrength * spec * lightColor.rgb;
     
     vec3 result = (ambient + diffuse + specular) * vertexColor;
     FragColor = vec4(result, 1.0);
 }
 )";
 
+// Render scales of the unit-sized meshes
+#define ENEMY_BASIC_RENDER_SCALE 1.0f
+#define ENEMY_FAST_RENDER_SCALE 0.8f
+#define ENEMY_HEAVY_RENDER_SCALE 1.4f
+#define PROJECTILE_RENDER_SCALE 0.15f
+
+// Half diagonal of the unit cube
+#define CUBE_BOUNDING_RADIUS 0.87f
+
+// Bounding sphere of an enemy's mesh at its render scale
+static float enemy_bounding_radius(int type) {
+    switch (type) {
+        case ENEMY_FAST:
+            return 0.5f * ENEMY_FAST_RENDER_SCALE;
+        case ENEMY_HEAVY:
+            return CUBE_BOUNDING_RADIUS * ENEMY_HEAVY_RENDER_SCALE;
+        default:
+            return CUBE_BOUNDING_RADIUS * ENEMY_BASIC_RENDER_SCALE;
+    }
+}
+
 Renderer::Renderer() : 
     window(nullptr),
-    shader_program(0),
+    frame_uniforms(),
     vao(0),
     vbo(0),
     ebo(0),
     window_width(1024),
     window_height(768),
-    initialized(false) {
+    initialized(false),
+    draw_calls(0),
+    frustum(),
+    culling_stats() {
 }
 
 Renderer::~Renderer() {
@@ -172,6 +215,22 @@ bool Renderer::initialize() {
         return false;
     }
     
+    // Initialize instance buffers for each mesh type
+    if (!cube_instances.initialize(get_cube_model()) ||
+        !sphere_instances.initialize(get_sphere_model()) ||
+        !plane_instances.initialize(get_plane_model())) {
+        std::cerr << "Failed to initialize instance buffers" << std::endl;
+        return false;
+    }
+    
+    // Everything is submitted through the render queue
+    render_queue.register_shader(RENDER_SHADER_LIT, &shader);
+    render_queue.register_mesh(RENDER_MESH_CUBE, draw_instances, &cube_instances);
+    render_queue.register_mesh(RENDER_MESH_SPHERE, draw_instances, &sphere_instances);
+    render_queue.register_mesh(RENDER_MESH_PLANE, draw_instances, &plane_instances);
+    render_queue.register_mesh(RENDER_MESH_TRAILS, draw_trails, this);
+    render_queue.register_mesh(RENDER_MESH_PARTICLES, draw_particles, this);
+    
     // Initialize camera
     camera.initialize();
     
@@ -190,82 +249,45 @@ bool Renderer::initialize() {
 }
 
 bool Renderer::create_shader_program() {
-    // Compile vertex shader
-    unsigned int vertex_shader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertex_shader, 1, &vertex_shader_source, NULL);
-    glCompileShader(vertex_shader);
-    
-    // Check vertex shader compilation
-    int success;
-    char info_log[512];
-    glGetShaderiv(vertex_shader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(vertex_shader, 512, NULL, info_log);
-        std::cerr << "Vertex shader compilation failed: " << info_log << std::endl;
+    if (!shader.create(vertex_shader_source, fragment_shader_source)) {
         return false;
     }
     
-    // Compile fragment shader
-    unsigned int fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragment_shader, 1, &fragment_shader_source, NULL);
-    glCompileShader(fragment_shader);
-    
-    // Check fragment shader compilation
-    glGetShaderiv(fragment_shader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(fragment_shader, 512, NULL, info_log);
-        std::cerr << "Fragment shader compilation failed: " << info_log << std::endl;
+    if (!frame_uniform_buffer.initialize()) {
         return false;
     }
     
-    // Create shader program
-    shader_program = glCreateProgram();
-    glAttachShader(shader_program, vertex_shader);
-    glAttachShader(shader_program, fragment_shader);
-    glLinkProgram(shader_program);
-    
-    // Check program linking
-    glGetProgramiv(shader_program, GL_LINK_STATUS, &success);
-    if (!success) {
-        glGetProgramInfoLog(shader_program, 512, NULL, info_log);
-        std::cerr << "Shader program linking failed: " << info_log << std::endl;
-        return false;
-    }
-    
-    // Clean up shaders
-    glDeleteShader(vertex_shader);
-    glDeleteShader(fragment_shader);
-    
     std::cout << "Shaders compiled and linked successfully" << std::endl;
     return true;
 }
 
 void Renderer::setup_lighting() {
-    // Set lighting uniforms
-    glUseProgram(shader_program);
+    // Lighting lives in the frame uniforms, uploaded with every frame
     
     // Light position (above and to the side)
-    int light_pos_loc = glGetUniformLocation(shader_program, "lightPos");
-    glUniform3f(light_pos_loc, 10.0f, 10.0f, 10.0f);
+    frame_uniforms.light_position[0] = 10.0f;
+    frame_uniforms.light_position[1] = 10.0f;
+    frame_uniforms.light_position[2] = 10.0f;
     
     // Light color (white)
-    int light_color_loc = glGetUniformLocation(shader_program, "lightColor");
-    glUniform3f(light_color_loc, 1.0f, 1.0f, 1.0f);
+    frame_uniforms.light_color[0] = 1.0f;
+    frame_uniforms.light_color[1] = 1.0f;
+    frame_uniforms.light_color[2] = 1.0f;
     
     // Ambient strength
-    int ambient_loc = glGetUniformLocation(shader_program, "ambientStrength");
-    glUniform1f(ambient_loc, 0.3f);
+    frame_uniforms.ambient_strength = 0.3f;
     
     // Specular strength
-    int specular_loc = glGetUniformLocation(shader_program, "specularStrength");
-    glUniform1f(specular_loc, 0.5f);
+    frame_uniforms.specular_strength = 0.5f;
     
     std::cout << "Lighting setup complete" << std::endl;
 }
 
-void Renderer::render_frame(const GameState& game_state) {
+void Renderer::render_frame(const GameState& game_state, float frame_time) {
     if (!initialized) return;
     
+    TRACE_SCOPE("Renderer::render_frame");
+    
 #ifdef GLFW_AVAILABLE
     if (glfwWindowShouldClose(window)) {
         return;
@@ -276,71 +298,102 @@ void Renderer::render_frame(const GameState& game_state) {
     glClearColor(0.1f, 0.1f, 0.2f, 1.0f);  // Dark blue background
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     
-    // Use shader program
-    glUseProgram(shader_program);
+    // Draw entities between the last two simulation ticks
+    float alpha = game_state.interpolation_alpha;
+    Vector3 player_position = interpolate_position(game_state.player.previous_position,
+                                                   game_state.player.position, alpha);
     
     // Update camera based on player state
-    camera.set_position(game_state.player.position.x, 
-                       game_state.player.position.y + 1.8f,  // Eye height
-                       game_state.player.position.z);
+    camera.set_position(player_position.x, 
+                       player_position.y + 1.8f,  // Eye height
+                       player_position.z);
     camera.set_rotation(game_state.player.rotation.x, game_state.player.rotation.y);
     
     // Get matrices
     Matrix4 view_matrix = camera.get_view_matrix();
     Matrix4 projection_matrix = camera.get_projection_matrix(window_width, window_height);
     
-    // Set uniforms
-    set_matrix_uniform("view", view_matrix);
-    set_matrix_uniform("projection", projection_matrix);
+    // Upload view, projection and camera data once for the whole frame
+    std::copy(view_matrix.data, view_matrix.data + 16, frame_uniforms.view);
+    std::copy(projection_matrix.data, projection_matrix.data + 16, frame_uniforms.projection);
+    frame_uniforms.view_position[0] = player_position.x;
+    frame_uniforms.view_position[1] = player_position.y + 1.8f;
+    frame_uniforms.view_position[2] = player_position.z;
+    frame_uniform_buffer.update(frame_uniforms);
+    
+    // Cull against the view frustum before any commands are queued.
+    // In column-major storage this product is projection * view.
+    frustum = extract_frustum(multiply_matrices(view_matrix, projection_matrix));
+    culling_stats = CullingStats();
+    
+    const EntityPool& enemy_pool = game_state.enemy_pool;
+    const EntityPool& projectile_pool = game_state.projectile_pool;
+    Arena* frame_arena = get_frame_arena();
+    
+    // Bounding spheres of live enemies, tested in one batch
+    SphereBatch enemy_spheres;
+    sphere_batch_begin(enemy_spheres, enemy_pool.count, frame_arena);
+    for (int i = 0; i < enemy_pool.count; i++) {
+        int slot = enemy_pool.alive[i];
+        const Enemy& enemy = game_state.enemies[slot];
+        if (enemy.ai_state == AI_DEAD || !enemy.is_active) continue;
+        
+        Vector3 enemy_position = interpolate_position(enemy.previous_position, enemy.position, alpha);
+        enemy_position.y += 0.5f;
+        sphere_batch_add(enemy_spheres, enemy_position, enemy_bounding_radius(enemy.type), slot);
+    }
+    cull_sphere_batch(enemy_spheres, frustum, culling_stats);
+    
+    // Same for projectiles
+    SphereBatch projectile_spheres;
+    sphere_batch_begin(projectile_spheres, projectile_pool.count, frame_arena);
+    for (int i = 0; i < projectile_pool.count; i++) {
+        int slot = projectile_pool.alive[i];
+        const Projectile& projectile = game_state.projectiles[slot];
+        
+        Vector3 projectile_position = interpolate_position(projectile.previous_position,
+                                                           projectile.position, alpha);
+        sphere_batch_add(projectile_spheres, projectile_position, PROJECTILE_RENDER_SCALE * 0.5f, slot);
+    }
+    cull_sphere_batch(projectile_spheres, frustum, culling_stats);
     
-    // Set view position for lighting
-    int view_pos_loc = glGetUniformLocation(shader_program, "viewPos");
-    glUniform3f(view_pos_loc, game_state.player.position.x, 
-                game_state.player.position.y + 1.8f, game_state.player.position.z);
+    // Queue the visible objects: the player and cube enemies share the cube
+    // mesh, sphere enemies and projectiles the sphere mesh. The ground,
+    // trails and particles are one command each.
+    render_queue.begin(1 + enemy_spheres.count + projectile_spheres.count + 3, frame_arena);
+    Vector3 eye = {player_position.x, player_position.y + 1.8f, player_position.z};
     
-    // Get model pointers
-    const Model* cube_model = get_cube_model();
-    const Model* sphere_model = get_sphere_model();
-    const Model* plane_model = get_plane_model();
+    // Mesh vertex colors are kept (blend 0) except for enemies
+    const Vector3 no_tint = {1.0f, 1.0f, 1.0f};
     
     // Render player (as a small cube at player position for debugging)
-    if (cube_model) {
-        Matrix4 player_model = create_translation_matrix(game_state.player.position.x,
-                                                        game_state.player.position.y + 0.5f,
-                                                        game_state.player.position.z);
-        player_model = multiply_matrices(player_model, create_scale_matrix(0.2f, 0.2f, 0.2f));
-        set_matrix_uniform("model", player_model);
-        cube_model->render();
-    }
+    Vector3 player_model_position = {player_position.x, player_position.y + 0.5f, player_position.z};
+    queue_instance(RENDER_MESH_CUBE, eye, player_model_position, 0.2f, no_tint, 0.0f);
     
-    // Render enemies with different models and colors based on type and AI state
-    for (int i = 0; i < game_state.enemy_count; i++) {
-        const Enemy& enemy = game_state.enemies[i];
-        if (enemy.ai_state == AI_DEAD || !enemy.is_active) continue;
-        
-        Matrix4 enemy_model = create_translation_matrix(enemy.position.x,
-                                                       enemy.position.y + 0.5f,
-                                                       enemy.position.z);
+    // Render visible enemies with different models and colors based on type and AI state
+    for (int i = 0; i < enemy_spheres.count; i++) {
+        const Enemy& enemy = game_state.enemies[enemy_spheres.ids[i]];
+        Vector3 enemy_position = {enemy_spheres.x[i], enemy_spheres.y[i], enemy_spheres.z[i]};
         
         // Choose model, scale, and color based on enemy type
-        const Model* enemy_model_ptr = nullptr;
+        RenderMesh enemy_mesh = RENDER_MESH_COUNT;
         float scale = 1.0f;
         Vector3 enemy_color = {1.0f, 0.0f, 0.0f}; // Default red
         
         switch (enemy.type) {
             case ENEMY_BASIC:
-                enemy_model_ptr = cube_model;
-                scale = 1.0f;
+                enemy_mesh = RENDER_MESH_CUBE;
+                scale = ENEMY_BASIC_RENDER_SCALE;
                 enemy_color = {0.8f, 0.2f, 0.2f}; // Dark red
                 break;
             case ENEMY_FAST:
-                enemy_model_ptr = sphere_model;
-                scale = 0.8f;
+                enemy_mesh = RENDER_MESH_SPHERE;
+                scale = ENEMY_FAST_RENDER_SCALE;
                 enemy_color = {0.2f, 0.8f, 0.2f}; // Green
                 break;
             case ENEMY_HEAVY:
-                enemy_model_ptr = cube_model;
-                scale = 1.4f;
+                enemy_mesh = RENDER_MESH_CUBE;
+                scale = ENEMY_HEAVY_RENDER_SCALE;
                 enemy_color = {0.2f, 0.2f, 0.8f}; // Blue
                 break;
         }
@@ -362,7 +415,7 @@ void Renderer::render_frame(const GameState& game_state) {
             case AI_ATTACK:
                 // Flash red for attacking enemies
                 static float attack_flash = 0.0f;
-                attack_flash += game_state.delta_time * 10.0f;
+                attack_flash += frame_time * 10.0f;
                 float flash_intensity = (sin(attack_flash) + 1.0f) * 0.5f;
                 enemy_color = {1.0f, flash_intensity * 0.3f, flash_intensity * 0.3f};
                 break;
@@ -376,53 +429,41 @@ void Renderer::render_frame(const GameState& game_state) {
             if (health_ratio < 0.3f) {
                 // Flash when low health
                 static float low_health_flash = 0.0f;
-                low_health_flash += game_state.delta_time * 8.0f;
+                low_health_flash += frame_time * 8.0f;
                 float flash = (sin(low_health_flash) + 1.0f) * 0.5f;
                 enemy_color.x = std::max(enemy_color.x, flash);
             }
         }
         
-        if (enemy_model_ptr) {
-            enemy_model = multiply_matrices(enemy_model, create_scale_matrix(scale, scale, scale));
-            set_matrix_uniform("model", enemy_model);
-            
-            // Set enemy color uniform
-            int color_loc = glGetUniformLocation(shader_program, "objectColor");
-            glUniform3f(color_loc, enemy_color.x, enemy_color.y, enemy_color.z);
-            
-            enemy_model_ptr->render();
+        if (enemy_mesh != RENDER_MESH_COUNT) {
+            queue_instance(enemy_mesh, eye, enemy_position, scale, enemy_color, 1.0f);
         }
     }
     
-    // Update and render projectile trails
-    projectile_trail.update(game_state, game_state.delta_time);
-    projectile_trail.render(shader_program);
-    
-    // Update and render hit effects
-    hit_effects.update(game_state.delta_time);
-    hit_effects.render(shader_program);
-    
-    // Render projectiles as small spheres with glow effect
-    if (sphere_model) {
-        for (int i = 0; i < game_state.projectile_count; i++) {
-            const Projectile& projectile = game_state.projectiles[i];
-            
-            Matrix4 projectile_model = create_translation_matrix(projectile.position.x,
-                                                               projectile.position.y,
-                                                               projectile.position.z);
-            projectile_model = multiply_matrices(projectile_model, create_scale_matrix(0.15f, 0.15f, 0.15f));
-            
-            set_matrix_uniform("model", projectile_model);
-            sphere_model->render();
-        }
+    // Render visible projectiles as small spheres
+    for (int i = 0; i < projectile_spheres.count; i++) {
+        Vector3 projectile_position = {projectile_spheres.x[i], projectile_spheres.y[i], projectile_spheres.z[i]};
+        queue_instance(RENDER_MESH_SPHERE, eye, projectile_position, PROJECTILE_RENDER_SCALE, no_tint, 0.0f);
     }
     
     // Render ground plane
-    if (plane_model) {
-        Matrix4 ground_model = create_translation_matrix(0.0f, -0.5f, 0.0f);
-        set_matrix_uniform("model", ground_model);
-        plane_model->render();
-    }
+    Vector3 ground_position = {0.0f, -0.5f, 0.0f};
+    queue_instance(RENDER_MESH_PLANE, eye, ground_position, 1.0f, no_tint, 0.0f);
+    
+    // Update projectile trails and hit effects; they draw after the opaque pass
+    projectile_trail.update(game_state, frame_time);
+    hit_effects.update(frame_time);
+    render_queue.push(RENDER_PASS_TRANSPARENT, RENDER_SHADER_LIT, RENDER_MESH_TRAILS,
+                      RENDER_MATERIAL_ALPHA_BLEND, 0.0f);
+    render_queue.push(RENDER_PASS_TRANSPARENT, RENDER_SHADER_LIT, RENDER_MESH_PARTICLES,
+                      RENDER_MATERIAL_ALPHA_BLEND, 0.0f);
+    
+    // Trails and particles have no instance buffer
+    set_default_instance_attributes();
+    
+    render_queue.sort();
+    render_queue.submit();
+    draw_calls = render_queue.get_stats().draw_calls;
     
 #ifdef GLFW_AVAILABLE
     // Swap buffers and poll events
@@ -433,11 +474,32 @@ void Renderer::render_frame(const GameState& game_state) {
 
 // Remove old render_cube function - now using Model system
 
-void Renderer::set_matrix_uniform(const char* name, const Matrix4& matrix) {
-    int location = glGetUniformLocation(shader_program, name);
-    if (location != -1) {
-        glUniformMatrix4fv(location, 1, GL_FALSE, matrix.data);
-    }
+void Renderer::queue_instance(RenderMesh mesh, const Vector3& eye, const Vector3& position, float scale,
+                              const Vector3& color, float color_blend) {
+    float dx = position.x - eye.x;
+    float dy = position.y - eye.y;
+    float dz = position.z - eye.z;
+    float distance = sqrtf(dx * dx + dy * dy + dz * dz);
+    
+    InstanceData instance = make_instance_data(position, scale, color, color_blend);
+    render_queue.push(RENDER_PASS_OPAQUE, RENDER_SHADER_LIT, mesh, RENDER_MATERIAL_OPAQUE, distance, &instance);
+}
+
+int Renderer::draw_instances(void* user_data, const InstanceData* instances, int count) {
+    return static_cast<InstanceBatch*>(user_data)->draw(instances, count);
+}
+
+// Trails and particles are immediate-mode geometry, not counted as mesh draws
+int Renderer::draw_trails(void* user_data, const InstanceData*, int) {
+    Renderer* renderer = static_cast<Renderer*>(user_data);
+    renderer->projectile_trail.render(renderer->shader);
+    return 0;
+}
+
+int Renderer::draw_particles(void* user_data, const InstanceData*, int) {
+    Renderer* renderer = static_cast<Renderer*>(user_data);
+    renderer->hit_effects.render(renderer->shader, renderer->frustum, renderer->culling_stats);
+    return 0;
 }
 
 bool Renderer::should_close() {
@@ -453,6 +515,11 @@ void Renderer::cleanup() {
     
     std::cout << "Cleaning up Graphics Engine..." << std::endl;
     
+    // Clean up instance buffers before the models they are attached to
+    cube_instances.cleanup();
+    sphere_instances.cleanup();
+    plane_instances.cleanup();
+    
     // Clean up models
     cleanup_models();
     
@@ -460,7 +527,8 @@ void Renderer::cleanup() {
     projectile_trail.cleanup();
     
     // Clean up OpenGL objects
-    if (shader_program) glDeleteProgram(shader_program);
+    frame_uniform_buffer.cleanup();
+    shader.destroy();
     
     camera.cleanup();
     
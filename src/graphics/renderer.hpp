@@ -1,10 +1,14 @@
 #ifndef RENDERER_HPP
 #define RENDERER_HPP
 
-#include "../game_api.h"
+#include "game_api.h"
 #include "camera.hpp"
 #include "projectile_trail.hpp"
 #include "hit_effects.hpp"
+#include "instance_batch.hpp"
+#include "shader_program.hpp"
+#include "frustum.hpp"
+#include "render_queue.hpp"
 
 #ifdef GLFW_AVAILABLE
 struct GLFWwindow;
@@ -31,6 +35,9 @@ Matrix4 create_look_at_matrix(float eye_x, float eye_y, float eye_z,
                              float center_x, float center_y, float center_z,
                              float up_x, float up_y, float up_z);
 
+// Blend between the previous and current simulation tick, t in [0, 1]
+Vector3 interpolate_position(const Vector3& previous, const Vector3& current, float t);
+
 // Graphics Engine class
 class Renderer {
 private:
@@ -40,7 +47,9 @@ private:
     void* window;
 #endif
     
-    unsigned int shader_program;
+    ShaderProgram shader;
+    FrameUniformBuffer frame_uniform_buffer;
+    FrameUniforms frame_uniforms;       // Lighting set once, camera every frame
     int window_width, window_height;
     bool initialized;
     
@@ -48,10 +57,25 @@ private:
     ProjectileTrail projectile_trail;
     HitEffectsSystem hit_effects;
     
+    // One instanced draw per mesh type
+    InstanceBatch cube_instances;
+    InstanceBatch sphere_instances;
+    InstanceBatch plane_instances;
+    RenderQueue render_queue;
+    int draw_calls;     // Instanced mesh draw calls issued by the last frame
+    Frustum frustum;    // This frame's view frustum
+    CullingStats culling_stats; // Frustum test results of the last frame
+    
     // Private methods
     bool create_shader_program();
     void setup_lighting();
-    void set_matrix_uniform(const char* name, const Matrix4& matrix);
+    void queue_instance(RenderMesh mesh, const Vector3& eye, const Vector3& position, float scale,
+                        const Vector3& color, float color_blend);
+    
+    // Render queue draw callbacks
+    static int draw_instances(void* user_data, const InstanceData* instances, int count);
+    static int draw_trails(void* user_data, const InstanceData* instances, int count);
+    static int draw_particles(void* user_data, const InstanceData* instances, int count);
     
 #ifdef GLFW_AVAILABLE
     static void framebuffer_size_callback(GLFWwindow* window, int width, int height);
@@ -62,13 +86,15 @@ public:
     ~Renderer();
     
     bool initialize();
-    void render_frame(const GameState& game_state);
+    void render_frame(const GameState& game_state, float frame_time);
     bool should_close();
     void cleanup();
     
     // Getters
     int get_window_width() const { return window_width; }
     int get_window_height() const { return window_height; }
+    int get_draw_calls() const { return draw_calls; }
+    const CullingStats& get_culling_stats() const { return culling_stats; }
 };
 
 #endif // RENDERER_HPP
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include "shader_program.hpp"
+#include <iostream>
+
+// OpenGL headers
+#ifdef _WIN32
+#include <windows.h>
+#include <GL/gl.h>
+#else
+#ifdef __APPLE__
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#endif
+#endif
+
+// Names of the ShaderUniform entries, in enum order
+static const char* const uniform_names[UNIFORM_COUNT] = {
+    "objectColor",
+    "particlePos",
+    "particleSize"
+};
+
+static unsigned int compile_shader(unsigned int type, const char* source, const char* label) {
+    unsigned int shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+    
+    int success;
+    char info_log[512];
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        glGetShaderInfoLog(shader, 512, NULL, info_log);
+        std::cerr << label << " shader compilation failed: " << info_log << std::endl;
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+ShaderProgram::ShaderProgram() : program(0) {
+    for (int i = 0; i < UNIFORM_COUNT; i++) {
+        uniform_locations[i] = -1;
+    }
+}
+
+ShaderProgram::~ShaderProgram() {
+    destroy();
+}
+
+bool ShaderProgram::create(const char* vertex_source, const char* fragment_source) {
+    destroy();
+    
+    unsigned int vertex_shader = compile_shader(GL_VERTEX_SHADER, vertex_source, "Vertex");
+    if (!vertex_shader) {
+        return false;
+    }
+    
+    unsigned int fragment_shader = compile_shader(GL_FRAGMENT_SHADER, fragment_source, "Fragment");
+    if (!fragment_shader) {
+        glDeleteShader(vertex_shader);
+        return false;
+    }
+    
+    program = glCreateProgram();
+    glAttachShader(program, vertex_shader);
+    glAttachShader(program, fragment_shader);
+    glLinkProgram(program);
+    
+    glDeleteShader(vertex_shader);
+    glDeleteShader(fragment_shader);
+    
+    int success;
+    char info_log[512];
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        glGetProgramInfoLog(program, 512, NULL, info_log);
+        std::cerr << "Shader program linking failed: " << info_log << std::endl;
+        destroy();
+        return false;
+    }
+    
+    resolve_uniforms();
+    return true;
+}
+
+void ShaderProgram::resolve_uniforms() {
+    for (int i = 0; i < UNIFORM_COUNT; i++) {
+        uniform_locations[i] = glGetUniformLocation(program, uniform_names[i]);
+    }
+    
+    // Every program reads the per-frame data from the same binding point
+    unsigned int block_index = glGetUniformBlockIndex(program, FRAME_UNIFORMS_BLOCK);
+    if (block_index != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, block_index, FRAME_UNIFORMS_BINDING);
+    }
+}
+
+void ShaderProgram::destroy() {
+    if (program) glDeleteProgram(program);
+    
+    program = 0;
+    for (int i = 0; i < UNIFORM_COUNT; i++) {
+        uniform_locations[i] = -1;
+    }
+}
+
+void ShaderProgram::use() const {
+    glUseProgram(program);
+}
+
+void ShaderProgram::set_float(ShaderUniform uniform, float value) const {
+    int location = uniform_locations[uniform];
+    if (location != -1) {
+        glUniform1f(location, value);
+    }
+}
+
+void ShaderProgram::set_vec3(ShaderUniform uniform, float x, float y, float z) const {
+    int location = uniform_locations[uniform];
+    if (location != -1) {
+        glUniform3f(location, x, y, z);
+    }
+}
+
+FrameUniformBuffer::FrameUniformBuffer() : ubo(0) {
+}
+
+FrameUniformBuffer::~FrameUniformBuffer() {
+    cleanup();
+}
+
+bool FrameUniformBuffer::initialize() {
+    glGenBuffers(1, &ubo);
+    if (!ubo) {
+        std::cerr << "Failed to create frame uniform buffer" << std::endl;
+        return false;
+    }
+    
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniforms), NULL, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_UNIFORMS_BINDING, ubo);
+    return true;
+}
+
+void FrameUniformBuffer::cleanup() {
+    if (ubo) glDeleteBuffers(1, &ubo);
+    ubo = 0;
+}
+
+void FrameUniformBuffer::update(const FrameUniforms& uniforms) {
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameUniforms), &uniforms);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
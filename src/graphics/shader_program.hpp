@@ -0,0 +1,69 @@
+#ifndef SHADER_PROGRAM_HPP
+#define SHADER_PROGRAM_HPP
+
+// Per-frame uniforms shared by every program through one uniform buffer.
+// Laid out std140 to match the FrameUniforms block in the shaders: vec3s
+// are stored as vec4s, which is how std140 aligns them anyway.
+struct FrameUniforms {
+    float view[16];
+    float projection[16];
+    float light_position[4];
+    float light_color[4];
+    float view_position[4];
+    float ambient_strength;
+    float specular_strength;
+    float padding[2];
+};
+
+#define FRAME_UNIFORMS_BLOCK "FrameUniforms"
+#define FRAME_UNIFORMS_BINDING 0
+
+// Uniforms a program may declare besides the FrameUniforms block
+enum ShaderUniform {
+    UNIFORM_OBJECT_COLOR,
+    UNIFORM_PARTICLE_POSITION,
+    UNIFORM_PARTICLE_SIZE,
+    UNIFORM_COUNT
+};
+
+// Linked program with its uniform locations resolved once at link time.
+// Setters skip uniforms the program does not declare.
+class ShaderProgram {
+private:
+    unsigned int program;
+    int uniform_locations[UNIFORM_COUNT];   // -1 when not declared
+    
+    void resolve_uniforms();
+
+public:
+    ShaderProgram();
+    ~ShaderProgram();
+    
+    bool create(const char* vertex_source, const char* fragment_source);
+    void destroy();
+    
+    void use() const;
+    void set_float(ShaderUniform uniform, float value) const;
+    void set_vec3(ShaderUniform uniform, float x, float y, float z) const;
+    
+    unsigned int get_id() const { return program; }
+    int get_location(ShaderUniform uniform) const { return uniform_locations[uniform]; }
+};
+
+// Uniform buffer holding FrameUniforms, bound to FRAME_UNIFORMS_BINDING
+class FrameUniformBuffer {
+private:
+    unsigned int ubo;
+
+public:
+    FrameUniformBuffer();
+    ~FrameUniformBuffer();
+    
+    bool initialize();
+    void cleanup();
+    
+    // Upload the whole block, once per frame
+    void update(const FrameUniforms& uniforms);
+};
+
+#endif // SHADER_PROGRAM_HPP
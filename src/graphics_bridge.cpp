@@ -1,6 +1,7 @@
 // Bridge between C Core Engine and C++ Graphics Engine
 #include "graphics/renderer.hpp"
 #include "game_api.h"
+#include "core/log.h"
 #include <iostream>
 
 // Global renderer instance
@@ -50,16 +51,16 @@ void create_hit_effect_at_position(float x, float y, float z, int effect_type, f
     
     // Access the hit effects system from renderer (we'll need to add a getter)
     // For now, just print debug info
-    std::cout << "Creating hit effect at (" << x << ", " << y << ", " << z 
-              << ") - Type: " << effect_type << ", Damage: " << damage << std::endl;
+    LOG_DEBUG(LOG_CATEGORY_GRAPHICS, "Creating hit effect at (%.2f, %.2f, %.2f) - Type: %d, Damage: %.1f",
+              position.x, position.y, position.z, effect_type, damage);
 }
 
-void render_game_frame(const GameState* game_state) {
+void render_game_frame(const GameState* game_state, float frame_time) {
     if (!g_renderer || !game_state) {
         return;
     }
     
-    g_renderer->render_frame(*game_state);
+    g_renderer->render_frame(*game_state, frame_time);
     
     // Render UI overlays
     render_speedometer_overlay(game_state);
@@ -222,6 +223,19 @@ int get_graphics_window_height() {
     return 0;
 }
 
+int get_render_culling_stats(int* visible, int* culled) {
+    if (!g_renderer) {
+        *visible = 0;
+        *culled = 0;
+        return 0;
+    }
+    
+    const CullingStats& stats = g_renderer->get_culling_stats();
+    *visible = stats.visible;
+    *culled = stats.culled;
+    return 1;
+}
+
 void cleanup_graphics_engine() {
     std::cout << "Cleaning up Graphics Bridge..." << std::endl;
     
@@ -2,6 +2,7 @@
 #define GRAPHICS_BRIDGE_H
 
 #include "game_api.h"
+#include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -9,7 +10,8 @@ extern "C" {
 
 // Graphics engine bridge functions
 bool init_graphics_engine();
-void render_game_frame(const GameState* game_state);
+// frame_time is the real time since the last frame, for visual-only effects
+void render_game_frame(const GameState* game_state, float frame_time);
 bool graphics_should_close();
 void cleanup_graphics_engine();
 
@@ -17,6 +19,10 @@ void cleanup_graphics_engine();
 int get_graphics_window_width();
 int get_graphics_window_height();
 
+// Objects the last frame drew and skipped by frustum culling (stats overlay),
+// returns 0 when nothing has been rendered
+int get_render_culling_stats(int* visible, int* culled);
+
 #ifdef __cplusplus
 }
 #endif
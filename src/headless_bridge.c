@@ -0,0 +1,103 @@
+// Headless stand-ins for the graphics and UI bridges
+// Linked into simple_shooter_bench instead of the OpenGL/C# sources so the
+// simulation builds and runs on machines without a GPU or window system
+
+#include <stdbool.h>
+#include "graphics_bridge.h"
+#include "ui_bridge.h"
+
+// Graphics engine bridge
+bool init_graphics_engine() {
+    return false;
+}
+
+void render_game_frame(const GameState* game_state, float frame_time) {
+    (void)game_state;
+    (void)frame_time;
+}
+
+bool graphics_should_close() {
+    return false;
+}
+
+void cleanup_graphics_engine() {
+}
+
+int get_graphics_window_width() {
+    return 0;
+}
+
+int get_graphics_window_height() {
+    return 0;
+}
+
+int get_render_culling_stats(int* visible, int* culled) {
+    *visible = 0;
+    *culled = 0;
+    return 0;
+}
+
+void create_hit_effect_at_position(float x, float y, float z, int effect_type, float damage) {
+    (void)x;
+    (void)y;
+    (void)z;
+    (void)effect_type;
+    (void)damage;
+}
+
+// UI manager bridge
+bool init_ui_manager() {
+    return false;
+}
+
+void update_ui_manager(float delta_time) {
+    (void)delta_time;
+}
+
+void render_ui_manager() {
+}
+
+void handle_ui_input(int key, int action) {
+    (void)key;
+    (void)action;
+}
+
+void cleanup_ui_manager() {
+}
+
+void render_text(const char* text, float x, float y, float r, float g, float b) {
+    (void)text;
+    (void)x;
+    (void)y;
+    (void)r;
+    (void)g;
+    (void)b;
+}
+
+void render_ui_background(float x, float y, float width, float height, float r, float g, float b, float a) {
+    (void)x;
+    (void)y;
+    (void)width;
+    (void)height;
+    (void)r;
+    (void)g;
+    (void)b;
+    (void)a;
+}
+
+void render_crosshair(float x, float y, float size, float r, float g, float b) {
+    (void)x;
+    (void)y;
+    (void)size;
+    (void)r;
+    (void)g;
+    (void)b;
+}
+
+int get_window_width() {
+    return 0;
+}
+
+int get_window_height() {
+    return 0;
+}
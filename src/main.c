@@ -3,6 +3,11 @@
 
 #include "core/game_loop.h"
 #include "core/game_state.h"
+#include "core/trace.h"
+#include "core/frame_stats.h"
+#include "core/replay.h"
+#include "core/snapshot.h"
+#include "core/rollback.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -13,6 +18,9 @@
 #define GAME_VERSION_PATCH 0
 #define GAME_VERSION_STRING "1.0.0"
 
+// Simulation ticks run by --headless when --ticks is not given
+#define DEFAULT_HEADLESS_TICKS 10000
+
 // Command line options
 static void print_usage(const char* program_name) {
     printf("Simple Shooter v%s\n", GAME_VERSION_STRING);
@@ -22,11 +30,35 @@ static void print_usage(const char* program_name) {
     printf("  --help, -h        Show this help message\n");
     printf("  --version, -v     Show version information\n");
     printf("  --test            Run in test mode (exits after initialization)\n");
-    printf("  --fps <number>    Set target FPS (default: 60)\n");
+    printf("  --headless        Run the simulation without graphics, UI or audio and\n");
+    printf("                    report ticks per second\n");
+    printf("  --ticks <n>       Ticks to simulate in headless mode (default: %d)\n", DEFAULT_HEADLESS_TICKS);
+    printf("  --fps <number>    Set target FPS, up to %d (default: 60)\n", MAX_TARGET_FPS);
     printf("  --windowed        Force windowed mode\n");
     printf("  --fullscreen      Force fullscreen mode\n");
     printf("  --no-audio        Disable audio system\n");
     printf("  --debug           Enable debug output\n");
+    printf("  --jobs <n>        Set worker thread count (default: one per extra core)\n");
+    printf("  --sim-thread      Simulate on a separate thread from rendering\n");
+    printf("  --no-sim-thread   Simulate and render on one thread\n");
+    printf("                    (default: separate thread on multi-core machines)\n");
+    printf("  --trace <file>    Record a Chrome trace (chrome://tracing, Perfetto) to file\n");
+    printf("  --frame-stats <file>\n");
+    printf("                    Write frame time percentiles to file at exit\n");
+    printf("                    (default: %s, 'none' disables)\n", DEFAULT_FRAME_STATS_FILE);
+    printf("  --hitch-ms <list> Comma separated hitch thresholds in ms (default: 25,50,100)\n");
+    printf("  --record <file>   Record all input to file for replay\n");
+    printf("  --replay <file>   Replay a recording (with --headless: as fast as possible)\n");
+    printf("  --seed <n>        Random seed (default: current time)\n");
+    printf("  --rollback <n>    Keep n ticks (up to %d) of rollback history; headless runs\n", ROLLBACK_MAX_WINDOW);
+    printf("                    rewind it regularly to check determinism (default: 0, off)\n");
+    printf("  --load-snapshot <file>\n");
+    printf("                    Start from a saved game state\n");
+    printf("  --save-snapshot <file>\n");
+    printf("                    Save the game state to file at exit\n");
+    printf("  --max-enemies <n> Set enemy capacity (default: %d)\n", DEFAULT_MAX_ENEMIES);
+    printf("  --max-projectiles <n>\n");
+    printf("                    Set projectile capacity (default: %d)\n", DEFAULT_MAX_PROJECTILES);
     printf("\nControls:\n");
     printf("  WASD              Move player\n");
     printf("  Mouse             Look around\n");
@@ -35,6 +67,7 @@ static void print_usage(const char* program_name) {
     printf("  ESC               Pause/Resume game\n");
     printf("  Q                 Quit game\n");
     printf("  O                 Open audio settings\n");
+    printf("  T                 Start/stop a trace capture to %s\n", DEFAULT_TRACE_FILE);
     printf("\nFeatures:\n");
     printf("  - Advanced bunny hop mechanics\n");
     printf("  - Real-time speedometer\n");
@@ -57,22 +90,98 @@ static void print_version() {
 // Global configuration
 typedef struct {
     int test_mode;
+    int headless_mode;
+    int headless_ticks;
     int target_fps;
     int windowed_mode;
     int fullscreen_mode;
     int no_audio;
     int debug_mode;
+    int max_enemies;
+    int max_projectiles;
+    int job_workers;
+    int sim_thread;
+    const char* trace_file;
+    const char* frame_stats_file;
+    float hitch_thresholds[FRAME_STATS_MAX_HITCH_THRESHOLDS];
+    int hitch_threshold_count;  // 0 keeps the defaults
+    const char* record_file;
+    const char* replay_file;
+    unsigned int seed;
+    int seed_set;
+    const char* load_snapshot_file;
+    const char* save_snapshot_file;
+    int rollback_window;
 } GameConfig;
 
 static GameConfig g_config = {
     .test_mode = 0,
+#ifdef SIMPLE_SHOOTER_HEADLESS
+    .headless_mode = 1,
+#else
+    .headless_mode = 0,
+#endif
+    .headless_ticks = DEFAULT_HEADLESS_TICKS,
     .target_fps = 60,
     .windowed_mode = 0,
     .fullscreen_mode = 0,
     .no_audio = 0,
-    .debug_mode = 0
+    .debug_mode = 0,
+    .max_enemies = DEFAULT_MAX_ENEMIES,
+    .max_projectiles = DEFAULT_MAX_PROJECTILES,
+    .job_workers = -1,
+    .sim_thread = -1,
+    .trace_file = NULL,
+    .frame_stats_file = DEFAULT_FRAME_STATS_FILE,
+    .hitch_threshold_count = 0,
+    .record_file = NULL,
+    .replay_file = NULL,
+    .seed = 0,
+    .seed_set = 0,
+    .load_snapshot_file = NULL,
+    .save_snapshot_file = NULL,
+    .rollback_window = 0
 };
 
+// Snapshot given by --load-snapshot, read before init for its capacities
+static StateSnapshot g_loaded_snapshot;
+
+// Parse a comma separated list of hitch thresholds, returns 0 on invalid input
+static int parse_hitch_thresholds(const char* value) {
+    int count = 0;
+    const char* cursor = value;
+    
+    while (*cursor) {
+        char* end;
+        float threshold = strtof(cursor, &end);
+        if (end == cursor || threshold <= 0.0f || count >= FRAME_STATS_MAX_HITCH_THRESHOLDS) {
+            return 0;
+        }
+        g_config.hitch_thresholds[count++] = threshold;
+        
+        if (*end == ',') {
+            end++;
+        } else if (*end != '\0') {
+            return 0;
+        }
+        cursor = end;
+    }
+    
+    g_config.hitch_threshold_count = count;
+    return count > 0;
+}
+
+// Parse an entity capacity argument, returns 0 on invalid input
+static int parse_capacity(const char* option, const char* value, int* out) {
+    int capacity = atoi(value);
+    if (capacity <= 0 || capacity > MAX_ENTITY_CAPACITY) {
+        printf("Error: Invalid %s value. Must be between 1 and %d.\n", option, MAX_ENTITY_CAPACITY);
+        return 0;
+    }
+    *out = capacity;
+    return 1;
+}
+
 // Parse command line arguments
 static int parse_arguments(int argc, char* argv[]) {
     for (int i = 1; i < argc; i++) {
@@ -87,11 +196,26 @@ static int parse_arguments(int argc, char* argv[]) {
         else if (strcmp(argv[i], "--test") == 0) {
             g_config.test_mode = 1;
         }
+        else if (strcmp(argv[i], "--headless") == 0) {
+            g_config.headless_mode = 1;
+        }
+        else if (strcmp(argv[i], "--ticks") == 0) {
+            if (i + 1 < argc) {
+                g_config.headless_ticks = atoi(argv[++i]);
+                if (g_config.headless_ticks <= 0) {
+                    printf("Error: Invalid --ticks value. Must be 1 or more.\n");
+                    return -1;
+                }
+            } else {
+                printf("Error: --ticks requires a number argument.\n");
+                return -1;
+            }
+        }
         else if (strcmp(argv[i], "--fps") == 0) {
             if (i + 1 < argc) {
                 g_config.target_fps = atoi(argv[++i]);
-                if (g_config.target_fps <= 0 || g_config.target_fps > 300) {
-                    printf("Error: Invalid FPS value. Must be between 1 and 300.\n");
+                if (g_config.target_fps <= 0 || g_config.target_fps > MAX_TARGET_FPS) {
+                    printf("Error: Invalid FPS value. Must be between 1 and %d.\n", MAX_TARGET_FPS);
                     return -1;
                 }
             } else {
@@ -111,6 +235,107 @@ static int parse_arguments(int argc, char* argv[]) {
         else if (strcmp(argv[i], "--debug") == 0) {
             g_config.debug_mode = 1;
         }
+        else if (strcmp(argv[i], "--jobs") == 0) {
+            if (i + 1 < argc) {
+                g_config.job_workers = atoi(argv[++i]);
+                if (g_config.job_workers < 0) {
+                    printf("Error: Invalid --jobs value. Must be 0 or more.\n");
+                    return -1;
+                }
+            } else {
+                printf("Error: --jobs requires a number argument.\n");
+                return -1;
+            }
+        }
+        else if (strcmp(argv[i], "--sim-thread") == 0) {
+            g_config.sim_thread = 1;
+        }
+        else if (strcmp(argv[i], "--no-sim-thread") == 0) {
+            g_config.sim_thread = 0;
+        }
+        else if (strcmp(argv[i], "--trace") == 0) {
+            if (i + 1 < argc) {
+                g_config.trace_file = argv[++i];
+            } else {
+                printf("Error: --trace requires a file name argument.\n");
+                return -1;
+            }
+        }
+        else if (strcmp(argv[i], "--frame-stats") == 0) {
+            if (i + 1 < argc) {
+                g_config.frame_stats_file = argv[++i];
+            } else {
+                printf("Error: --frame-stats requires a file name argument.\n");
+                return -1;
+            }
+        }
+        else if (strcmp(argv[i], "--hitch-ms") == 0) {
+            if (i + 1 >= argc || !parse_hitch_thresholds(argv[++i])) {
+                printf("Error: --hitch-ms requires 1 to %d positive numbers separated by commas.\n",
+                       FRAME_STATS_MAX_HITCH_THRESHOLDS);
+                return -1;
+            }
+        }
+        else if (strcmp(argv[i], "--record") == 0 || strcmp(argv[i], "--replay") == 0) {
+            if (i + 1 >= argc) {
+                printf("Error: %s requires a file name argument.\n", argv[i]);
+                return -1;
+            }
+            if (strcmp(argv[i], "--record") == 0) {
+                g_config.record_file = argv[++i];
+            } else {
+                g_config.replay_file = argv[++i];
+            }
+        }
+        else if (strcmp(argv[i], "--load-snapshot") == 0 || strcmp(argv[i], "--save-snapshot") == 0) {
+            if (i + 1 >= argc) {
+                printf("Error: %s requires a file name argument.\n", argv[i]);
+                return -1;
+            }
+            if (strcmp(argv[i], "--load-snapshot") == 0) {
+                g_config.load_snapshot_file = argv[++i];
+            } else {
+                g_config.save_snapshot_file = argv[++i];
+            }
+        }
+        else if (strcmp(argv[i], "--rollback") == 0) {
+            if (i + 1 < argc) {
+                g_config.rollback_window = atoi(argv[++i]);
+                if (g_config.rollback_window < 0 || g_config.rollback_window > ROLLBACK_MAX_WINDOW) {
+                    printf("Error: Invalid --rollback value. Must be between 0 and %d.\n", ROLLBACK_MAX_WINDOW);
+                    return -1;
+                }
+            } else {
+                printf("Error: --rollback requires a number argument.\n");
+                return -1;
+            }
+        }
+        else if (strcmp(argv[i], "--seed") == 0) {
+            if (i + 1 < argc) {
+                char* end;
+                g_config.seed = (unsigned int)strtoul(argv[++i], &end, 10);
+                if (*end != '\0') {
+                    printf("Error: Invalid --seed value. Must be a number.\n");
+                    return -1;
+                }
+                g_config.seed_set = 1;
+            } else {
+                printf("Error: --seed requires a number argument.\n");
+                return -1;
+            }
+        }
+        else if (strcmp(argv[i], "--max-enemies") == 0 || strcmp(argv[i], "--max-projectiles") == 0) {
+            int is_enemies = strcmp(argv[i], "--max-enemies") == 0;
+            if (i + 1 >= argc) {
+                printf("Error: %s requires a number argument.\n", argv[i]);
+                return -1;
+            }
+            int* target = is_enemies ? &g_config.max_enemies : &g_config.max_projectiles;
+            if (!parse_capacity(argv[i], argv[i + 1], target)) {
+                return -1;
+            }
+            i++;
+        }
         else {
             printf("Error: Unknown option '%s'\n", argv[i]);
             printf("Use --help for usage information.\n");
@@ -118,6 +343,17 @@ static int parse_arguments(int argc, char* argv[]) {
         }
     }
     
+    if (g_config.record_file && g_config.replay_file) {
+        printf("Error: --record and --replay cannot be combined.\n");
+        return -1;
+    }
+    
+    // Recordings always start from a fresh level
+    if (g_config.load_snapshot_file && (g_config.record_file || g_config.replay_file)) {
+        printf("Error: --load-snapshot cannot be combined with --record or --replay.\n");
+        return -1;
+    }
+    
     return 1; // Continue execution
 }
 
@@ -140,8 +376,70 @@ static int initialize_game() {
         printf("Audio system disabled by command line option\n");
     }
     
+    // A replay runs with the capacities and mode it was recorded with
+    if (g_config.replay_file) {
+        if (!replay_load(g_config.replay_file)) {
+            return 0;
+        }
+        
+        const ReplayHeader* header = replay_get_header();
+        if (header->tick_rate != SIMULATION_TICK_RATE) {
+            printf("Warning: replay was recorded at %d Hz, simulating at %d Hz\n",
+                   header->tick_rate, SIMULATION_TICK_RATE);
+        }
+        g_config.max_enemies = header->max_enemies;
+        g_config.max_projectiles = header->max_projectiles;
+        if (header->flags & REPLAY_FLAG_HEADLESS) {
+            g_config.headless_mode = 1;
+        }
+    }
+    
+    // A snapshot only loads into a level of the capacities it was saved with
+    if (g_config.load_snapshot_file) {
+        if (!read_game_snapshot(g_config.load_snapshot_file, &g_loaded_snapshot, NULL) ||
+            !snapshot_get_capacities(&g_loaded_snapshot, &g_config.max_enemies, &g_config.max_projectiles)) {
+            free_game_snapshot(&g_loaded_snapshot);
+            return 0;
+        }
+    }
+    
+    // Entity storage is sized when the core engine initializes the game state
+    set_entity_capacities(g_config.max_enemies, g_config.max_projectiles);
+    set_job_worker_count(g_config.job_workers);
+    set_headless_mode(g_config.headless_mode);
+    set_sim_thread_mode(g_config.sim_thread);
+    set_record_file(g_config.record_file);
+    if (g_config.seed_set) {
+        set_random_seed(g_config.seed);
+    }
+    set_rollback_window(g_config.rollback_window);
+    
+    frame_stats_set_csv_path(strcmp(g_config.frame_stats_file, "none") == 0 ? NULL : g_config.frame_stats_file);
+    if (g_config.hitch_threshold_count > 0) {
+        frame_stats_set_hitch_thresholds(g_config.hitch_thresholds, g_config.hitch_threshold_count);
+    }
+    
     // Initialize core engine
-    init_core_engine();
+    if (!init_core_engine()) {
+        return 0;
+    }
+    
+    if (g_config.load_snapshot_file) {
+        int loaded = load_game_snapshot(&g_loaded_snapshot);
+        if (loaded) {
+            printf("Loaded snapshot %s - tick %lu, %d enemies\n", g_config.load_snapshot_file,
+                   g_loaded_snapshot.tick, get_game_state()->enemy_count);
+        }
+        free_game_snapshot(&g_loaded_snapshot);
+        if (!loaded) {
+            cleanup_core();
+            return 0;
+        }
+    }
+    
+    if (g_config.trace_file) {
+        trace_start(g_config.trace_file);
+    }
     
     printf("Game systems initialized successfully!\n");
     printf("=================================\n");
@@ -149,6 +447,19 @@ static int initialize_game() {
     return 1;
 }
 
+// Write the final game state for --save-snapshot, the loop has stopped by now
+static void save_snapshot_at_exit() {
+    if (!g_config.save_snapshot_file) {
+        return;
+    }
+    
+    StateSnapshot snapshot = {0};
+    if (save_game_snapshot(&snapshot) && write_game_snapshot(g_config.save_snapshot_file, &snapshot, NULL)) {
+        printf("Saved snapshot %s - tick %lu, %zu bytes\n", g_config.save_snapshot_file, snapshot.tick, snapshot.size);
+    }
+    free_game_snapshot(&snapshot);
+}
+
 // Main game entry point
 int main(int argc, char* argv[]) {
     printf("Starting Simple Shooter...\n");
@@ -172,6 +483,15 @@ int main(int argc, char* argv[]) {
         return EXIT_SUCCESS;
     }
     
+    // Headless mode - simulate a fixed number of ticks and report timings
+    if (g_config.headless_mode) {
+        // A replay runs exactly the ticks it recorded
+        run_headless_loop(replay_is_playing() ? (int)replay_end_tick() : g_config.headless_ticks);
+        save_snapshot_at_exit();
+        cleanup_core();
+        return EXIT_SUCCESS;
+    }
+    
     // Print startup information
     printf("\nGame ready! Starting main loop...\n");
     printf("Use --help for controls and options.\n");
@@ -180,16 +500,11 @@ int main(int argc, char* argv[]) {
     // Run main game loop
     int exit_code = EXIT_SUCCESS;
     
-    try {
-        run_game_loop();
-        printf("\nGame loop ended normally.\n");
-    }
-    catch (...) {
-        printf("\nGame loop ended with error.\n");
-        exit_code = EXIT_FAILURE;
-    }
+    run_game_loop();
+    printf("\nGame loop ended normally.\n");
     
     // Cleanup
+    save_snapshot_at_exit();
     printf("Cleaning up game systems...\n");
     cleanup_core();
     
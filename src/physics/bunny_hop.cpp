@@ -1,5 +1,6 @@
 #include "bunny_hop.hpp"
-#include "../game_api.h"
+#include "game_api.h"
+#include "../core/log.h"
 #include <iostream>
 #include <cmath>
 #include <algorithm>
@@ -43,9 +44,6 @@ void BunnyHopController::update_movement(PlayerState& player, const InputState&
         return;
     }
     
-    // Cap delta time for stability
-    delta_time = std::min(delta_time, 0.033f);
-    
     // Check if player is on ground
     bool was_on_ground = player.on_ground;
     player.on_ground = is_on_ground(player);
@@ -86,7 +84,7 @@ void BunnyHopController::update_movement(PlayerState& player, const InputState&
     }
     
     // Update speed calculations
-    update_speed_calculations(player);
+    update_speed_calculations(player, delta_time);
 }
 
 bool BunnyHopController::is_on_ground(const PlayerState& player) {
@@ -99,8 +97,8 @@ void BunnyHopController::perform_jump(PlayerState& player) {
     player.last_jump_time = 0.0f;
     player.consecutive_jumps++;
     
-    std::cout << "Jump! Consecutive: " << player.consecutive_jumps 
-              << ", Speed: " << player.speed << " u/s" << std::endl;
+    LOG_DEBUG(LOG_CATEGORY_PHYSICS, "Jump! Consecutive: %d, Speed: %.2f u/s",
+              player.consecutive_jumps, player.speed);
 }
 
 void BunnyHopController::update_ground_movement(PlayerState& player, const InputState& input, float delta_time) {
@@ -204,8 +202,8 @@ void BunnyHopController::update_air_movement(PlayerState& player, const InputSta
     
     // Debug output for good strafes
     if (is_good_strafe && current_speed > max_ground_speed) {
-        std::cout << "Good strafe! Angle: " << strafe_angle 
-                  << "°, Speed: " << new_speed << " u/s" << std::endl;
+        LOG_DEBUG(LOG_CATEGORY_PHYSICS, "Good strafe! Angle: %.1f°, Speed: %.2f u/s",
+                  strafe_angle, new_speed);
     }
 }
 
@@ -293,7 +291,7 @@ void BunnyHopController::on_landing(PlayerState& player) {
     float horizontal_speed = sqrtf(player.velocity.x * player.velocity.x + player.velocity.z * player.velocity.z);
     
     if (horizontal_speed > max_ground_speed) {
-        std::cout << "Bunny hop landing! Speed preserved: " << horizontal_speed << " u/s" << std::endl;
+        LOG_DEBUG(LOG_CATEGORY_PHYSICS, "Bunny hop landing! Speed preserved: %.2f u/s", horizontal_speed);
         
         // Slightly reduce speed on landing but preserve most of it
         float preservation_factor = 0.95f;
@@ -302,7 +300,7 @@ void BunnyHopController::on_landing(PlayerState& player) {
     }
 }
 
-void BunnyHopController::update_speed_calculations(PlayerState& player) {
+void BunnyHopController::update_speed_calculations(PlayerState& player, float delta_time) {
     // Calculate horizontal speed
     player.horizontal_speed = sqrtf(player.velocity.x * player.velocity.x + player.velocity.z * player.velocity.z);
     
@@ -313,7 +311,7 @@ void BunnyHopController::update_speed_calculations(PlayerState& player) {
     
     // Reset consecutive jumps if on ground for too long
     if (player.on_ground) {
-        player.last_jump_time += 0.016f; // Assume ~60 FPS
+        player.last_jump_time += delta_time;
         if (player.last_jump_time > 1.0f) {
             player.consecutive_jumps = 0;
         }
@@ -355,6 +353,22 @@ float BunnyHopController::get_max_air_speed() const { return max_air_speed; }
 float BunnyHopController::get_jump_velocity() const { return jump_velocity; }
 float BunnyHopController::get_speed_gain_factor() const { return speed_gain_factor; }
 
+BunnyHopTuning BunnyHopController::get_tuning() const {
+    BunnyHopTuning tuning;
+    tuning.max_ground_speed = max_ground_speed;
+    tuning.max_air_speed = max_air_speed;
+    tuning.jump_velocity = jump_velocity;
+    tuning.speed_gain_factor = speed_gain_factor;
+    return tuning;
+}
+
+void BunnyHopController::set_tuning(const BunnyHopTuning& tuning) {
+    max_ground_speed = tuning.max_ground_speed;
+    max_air_speed = tuning.max_air_speed;
+    jump_velocity = tuning.jump_velocity;
+    speed_gain_factor = tuning.speed_gain_factor;
+}
+
 void BunnyHopController::cleanup() {
     if (!initialized) {
         return;
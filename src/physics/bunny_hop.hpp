@@ -1,7 +1,15 @@
 #ifndef BUNNY_HOP_HPP
 #define BUNNY_HOP_HPP
 
-#include "../game_api.h"
+#include "game_api.h"
+
+// Tunable parameters, saved with game snapshots
+struct BunnyHopTuning {
+    float max_ground_speed;
+    float max_air_speed;
+    float jump_velocity;
+    float speed_gain_factor;
+};
 
 class BunnyHopController {
 private:
@@ -28,7 +36,7 @@ private:
     void update_ground_movement(PlayerState& player, const InputState& input, float delta_time);
     void update_air_movement(PlayerState& player, const InputState& input, float delta_time);
     void on_landing(PlayerState& player);
-    void update_speed_calculations(PlayerState& player);
+    void update_speed_calculations(PlayerState& player, float delta_time);
 
 public:
     BunnyHopController();
@@ -58,6 +66,10 @@ public:
     float get_max_air_speed() const;
     float get_jump_velocity() const;
     float get_speed_gain_factor() const;
+    
+    // Restores every tunable at once without logging
+    BunnyHopTuning get_tuning() const;
+    void set_tuning(const BunnyHopTuning& tuning);
 };
 
 #endif // BUNNY_HOP_HPP
\ No newline at end of file
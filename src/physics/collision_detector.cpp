@@ -1,9 +1,12 @@
 #include "collision_detector.hpp"
+#include "physics_engine.hpp"
 #include <iostream>
 #include <cmath>
 #include <algorithm>
 
-CollisionDetector::CollisionDetector() : initialized(false) {
+CollisionDetector::CollisionDetector() :
+    collision_pairs(ArenaAllocator<CollisionInfo>(get_tick_arena())),
+    initialized(false) {
 }
 
 CollisionDetector::~CollisionDetector() {
@@ -21,8 +24,8 @@ void CollisionDetector::detect_collisions(std::vector<RigidBody>& bodies) {
         return;
     }
     
-    // Clear previous collision data
-    collision_pairs.clear();
+    // The previous tick's pairs went with the tick arena reset, start over
+    collision_pairs = ArenaVector<CollisionInfo>(collision_pairs.get_allocator());
     
     // Check all pairs of bodies
     for (size_t i = 0; i < bodies.size(); i++) {
@@ -207,7 +210,7 @@ float CollisionDetector::distance_between_bodies(const RigidBody& a, const Rigid
     return sqrtf(dx * dx + dy * dy + dz * dz);
 }
 
-const std::vector<CollisionInfo>& CollisionDetector::get_collision_pairs() const {
+const ArenaVector<CollisionInfo>& CollisionDetector::get_collision_pairs() const {
     return collision_pairs;
 }
 
@@ -216,7 +219,7 @@ void CollisionDetector::cleanup() {
         return;
     }
     
-    collision_pairs.clear();
+    collision_pairs = ArenaVector<CollisionInfo>(collision_pairs.get_allocator());
     initialized = false;
     std::cout << "Collision Detector cleaned up" << std::endl;
 }
\ No newline at end of file
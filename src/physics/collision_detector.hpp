@@ -1,7 +1,8 @@
 #ifndef COLLISION_DETECTOR_HPP
 #define COLLISION_DETECTOR_HPP
 
-#include "../game_api.h"
+#include "game_api.h"
+#include "../core/arena_allocator.hpp"
 #include <vector>
 
 // Forward declaration
@@ -23,7 +24,7 @@ struct CollisionInfo {
 
 class CollisionDetector {
 private:
-    std::vector<CollisionInfo> collision_pairs;
+    ArenaVector<CollisionInfo> collision_pairs; // This tick's contacts, in the tick arena
     bool initialized;
     
     void resolve_collision(RigidBody& a, RigidBody& b, const CollisionInfo& collision);
@@ -45,7 +46,7 @@ public:
     float distance_between_bodies(const RigidBody& a, const RigidBody& b);
     
     // Getters
-    const std::vector<CollisionInfo>& get_collision_pairs() const;
+    const ArenaVector<CollisionInfo>& get_collision_pairs() const;
 };
 
 #endif // COLLISION_DETECTOR_HPP
\ No newline at end of file
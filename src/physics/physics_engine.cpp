@@ -1,10 +1,25 @@
 #include "physics_engine.hpp"
 #include "collision_detector.hpp"
 #include "bunny_hop.hpp"
-#include "../game_api.h"
+#include "game_api.h"
+#include "../core/job_system.h"
+#include "../core/trace.h"
 #include <iostream>
 #include <cmath>
 #include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+// Fixed part of a saved physics state, followed by the rigid bodies
+struct PhysicsStateHeader {
+    float gravity;
+    float air_resistance;
+    float ground_friction;
+    BunnyHopTuning bunny_hop;
+    int body_count;
+};
+
+static_assert(std::is_trivially_copyable<RigidBody>::value, "rigid bodies are saved with memcpy");
 
 PhysicsEngine::PhysicsEngine() : 
     gravity(-9.81f),
@@ -45,13 +60,21 @@ void PhysicsEngine::update(float delta_time) {
         return;
     }
     
-    // Cap delta time to prevent instability
-    delta_time = std::min(delta_time, 0.033f); // Max 30 FPS equivalent
+    TRACE_SCOPE("PhysicsEngine::update");
     
-    // Update all rigid bodies
-    for (auto& body : rigid_bodies) {
-        update_rigid_body(body, delta_time);
-    }
+    // Update all rigid bodies, bodies are independent until collision detection
+    struct UpdateJob {
+        PhysicsEngine* engine;
+        float delta_time;
+    } job = {this, delta_time};
+    
+    job_system_parallel_for(static_cast<int>(rigid_bodies.size()), 64,
+        [](void* user_data, int begin, int end, int) {
+            UpdateJob* job = static_cast<UpdateJob*>(user_data);
+            for (int i = begin; i < end; i++) {
+                job->engine->update_rigid_body(job->engine->rigid_bodies[i], job->delta_time);
+            }
+        }, &job);
     
     // Process collisions
     collision_detector.detect_collisions(rigid_bodies);
@@ -279,6 +302,53 @@ int PhysicsEngine::get_rigid_body_count() const {
     return count;
 }
 
+size_t PhysicsEngine::save_state(void* buffer, size_t capacity) const {
+    size_t bodies_size = rigid_bodies.size() * sizeof(RigidBody);
+    size_t size = sizeof(PhysicsStateHeader) + bodies_size;
+    if (!buffer || capacity < size) {
+        return size;
+    }
+    
+    PhysicsStateHeader header;
+    header.gravity = gravity;
+    header.air_resistance = air_resistance;
+    header.ground_friction = ground_friction;
+    header.bunny_hop = bunny_hop_controller.get_tuning();
+    header.body_count = static_cast<int>(rigid_bodies.size());
+    
+    unsigned char* bytes = static_cast<unsigned char*>(buffer);
+    std::memcpy(bytes, &header, sizeof(header));
+    if (bodies_size > 0) {
+        std::memcpy(bytes + sizeof(header), rigid_bodies.data(), bodies_size);
+    }
+    return size;
+}
+
+bool PhysicsEngine::load_state(const void* data, size_t size) {
+    PhysicsStateHeader header;
+    if (size < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    
+    size_t bodies_size = static_cast<size_t>(header.body_count) * sizeof(RigidBody);
+    if (header.body_count < 0 || size != sizeof(header) + bodies_size) {
+        return false;
+    }
+    
+    gravity = header.gravity;
+    air_resistance = header.air_resistance;
+    ground_friction = header.ground_friction;
+    bunny_hop_controller.set_tuning(header.bunny_hop);
+    
+    // Keeps the vector's capacity, so restoring every tick does not allocate
+    rigid_bodies.resize(header.body_count);
+    if (bodies_size > 0) {
+        std::memcpy(rigid_bodies.data(), static_cast<const unsigned char*>(data) + sizeof(header), bodies_size);
+    }
+    return true;
+}
+
 void PhysicsEngine::apply_bunny_hop(PlayerState& player, const InputState& input, float delta_time) {
     if (initialized) {
         bunny_hop_controller.update_movement(player, input, delta_time);
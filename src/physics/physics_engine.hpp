@@ -1,10 +1,11 @@
 #ifndef PHYSICS_ENGINE_HPP
 #define PHYSICS_ENGINE_HPP
 
-#include "../game_api.h"
+#include "game_api.h"
 #include "collision_detector.hpp"
 #include "bunny_hop.hpp"
 #include <vector>
+#include <cstddef>
 
 // Bounding box structure
 struct BoundingBox {
@@ -100,6 +101,12 @@ public:
     float get_air_resistance() const { return air_resistance; }
     float get_ground_friction() const { return ground_friction; }
     int get_rigid_body_count() const;
+    
+    // Snapshot support: settings, bunny hop tuning and every rigid body as
+    // one flat block. save_state returns the size needed and writes nothing
+    // when capacity is smaller.
+    size_t save_state(void* buffer, size_t capacity) const;
+    bool load_state(const void* data, size_t size);
 };
 
 #endif // PHYSICS_ENGINE_HPP
\ No newline at end of file
@@ -117,6 +117,20 @@ int get_physics_body_count() {
     return 0;
 }
 
+size_t save_physics_snapshot(void* buffer, size_t capacity) {
+    if (g_physics_engine) {
+        return g_physics_engine->save_state(buffer, capacity);
+    }
+    return 0;
+}
+
+int load_physics_snapshot(const void* data, size_t size) {
+    if (g_physics_engine) {
+        return g_physics_engine->load_state(data, size) ? 1 : 0;
+    }
+    return size == 0;
+}
+
 void apply_bunny_hop_movement(PlayerState* player, const InputState* input, float delta_time) {
     if (g_physics_engine && player && input) {
         g_physics_engine->apply_bunny_hop(*player, *input, delta_time);
@@ -2,6 +2,8 @@
 #define PHYSICS_BRIDGE_H
 
 #include "game_api.h"
+#include <stdbool.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -35,6 +37,11 @@ void set_physics_gravity(float gravity);
 // Query functions
 int get_physics_body_count();
 
+// Flat copy of the rigid bodies and tuning for game snapshots. Returns the
+// size needed, nothing is written when capacity is smaller.
+size_t save_physics_snapshot(void* buffer, size_t capacity);
+int load_physics_snapshot(const void* data, size_t size);
+
 // Bunny hop functions
 void apply_bunny_hop_movement(PlayerState* player, const InputState* input, float delta_time);
 void set_bunny_hop_max_ground_speed(float speed);
@@ -15,6 +15,18 @@ namespace SimpleShooter.UI
         private int ammoCounterX, ammoCounterY;
         private int scoreDisplayX, scoreDisplayY;
         private int crosshairX, crosshairY;
+        private int frameStatsX, frameStatsY;
+        
+        // Frame time percentiles from the core, last completed window
+        private FrameStatsSummary frameStats;
+        private FrameStatsSummary simulationStats;
+        private FrameStatsSummary renderStats;
+        private bool hasFrameStats = false;
+        private bool showFrameStats = true;
+        
+        // Frustum culling results of the last rendered frame
+        private int visibleObjects;
+        private int culledObjects;
         
         // HUD element sizes
         private const int HEALTH_BAR_WIDTH = 200;
@@ -66,6 +78,10 @@ namespace SimpleShooter.UI
             scoreDisplayX = 20;
             scoreDisplayY = 20;
             
+            // Frame stats - top left, under the score
+            frameStatsX = 20;
+            frameStatsY = 50;
+            
             // Crosshair - center
             crosshairX = windowWidth / 2;
             crosshairY = windowHeight / 2;
@@ -79,6 +95,24 @@ namespace SimpleShooter.UI
             // Could add animations or effects here
         }
 
+        public void UpdateFrameStats(FrameStatsSummary frame, FrameStatsSummary simulation, FrameStatsSummary render)
+        {
+            if (!initialized) return;
+            
+            frameStats = frame;
+            simulationStats = simulation;
+            renderStats = render;
+            hasFrameStats = true;
+        }
+
+        public void UpdateCullingStats(int visible, int culled)
+        {
+            if (!initialized) return;
+            
+            visibleObjects = visible;
+            culledObjects = culled;
+        }
+
         public void Render()
         {
             if (!initialized) return;
@@ -103,6 +137,12 @@ namespace SimpleShooter.UI
                 // Render score
                 RenderScore(score);
                 
+                // Render frame time percentiles
+                if (showFrameStats && hasFrameStats)
+                {
+                    RenderFrameStats();
+                }
+                
                 // Render crosshair
                 RenderCrosshair();
                 
@@ -181,6 +221,48 @@ namespace SimpleShooter.UI
             }
         }
 
+        private void RenderFrameStats()
+        {
+            try
+            {
+                render_ui_background(frameStatsX - 5, frameStatsY - 5, 330, 105, 0.0f, 0.0f, 0.0f, 0.6f);
+                
+                string frameText = $"Frame  p50 {frameStats.p50_ms:F1}  p99 {frameStats.p99_ms:F1}  " +
+                                   $"p99.9 {frameStats.p999_ms:F1}  max {frameStats.max_ms:F1} ms";
+                render_text(frameText, frameStatsX, frameStatsY, 1.0f, 1.0f, 1.0f);
+                
+                string simulationText = $"Sim    p50 {simulationStats.p50_ms:F2}  p99 {simulationStats.p99_ms:F2} ms";
+                render_text(simulationText, frameStatsX, frameStatsY + 20, 0.8f, 0.8f, 0.8f);
+                
+                string renderText = $"Render p50 {renderStats.p50_ms:F2}  p99 {renderStats.p99_ms:F2} ms";
+                render_text(renderText, frameStatsX, frameStatsY + 40, 0.8f, 0.8f, 0.8f);
+                
+                // Hitch counts per threshold, red once any frame crossed one
+                string hitchText = "Hitches";
+                uint totalHitches = 0;
+                for (int i = 0; i < frameStats.hitch_threshold_count; i++)
+                {
+                    hitchText += $"  >{frameStats.hitch_threshold_ms[i]:F0}ms: {frameStats.hitches[i]}";
+                    totalHitches += frameStats.hitches[i];
+                }
+                if (totalHitches > 0)
+                {
+                    render_text(hitchText, frameStatsX, frameStatsY + 60, 1.0f, 0.3f, 0.3f);
+                }
+                else
+                {
+                    render_text(hitchText, frameStatsX, frameStatsY + 60, 0.5f, 1.0f, 0.5f);
+                }
+                
+                string cullingText = $"Culling  visible {visibleObjects}  culled {culledObjects}";
+                render_text(cullingText, frameStatsX, frameStatsY + 80, 0.8f, 0.8f, 0.8f);
+            }
+            catch (Exception ex)
+            {
+                Console.WriteLine($"Frame stats render error: {ex.Message}");
+            }
+        }
+
         private void RenderCrosshair()
         {
             try
@@ -234,5 +316,11 @@ namespace SimpleShooter.UI
         }
 
         public bool IsInitialized => initialized;
+        
+        public bool ShowFrameStats
+        {
+            get => showFrameStats;
+            set => showFrameStats = value;
+        }
     }
 }
\ No newline at end of file
@@ -16,7 +16,11 @@ namespace SimpleShooter.UI
         private int positionX;
         private int positionY;
         private int width = 200;
-        private int height = 80;
+        private int height = 100;
+        
+        // Tail frame time from the core frame stats
+        private float frameTimeP99;
+        private const float FRAME_TIME_WARNING_MS = 33.3f;
         
         // Speed thresholds for color coding
         private const float NORMAL_SPEED_THRESHOLD = 10.0f;
@@ -66,6 +70,13 @@ namespace SimpleShooter.UI
             UpdateSpeedColor();
         }
 
+        public void UpdateFrameStats(FrameStatsSummary frameStats)
+        {
+            if (!initialized) return;
+            
+            frameTimeP99 = frameStats.p99_ms;
+        }
+
         private void UpdateSpeedColor()
         {
             if (currentSpeed >= BUNNY_HOP_THRESHOLD)
@@ -110,6 +121,17 @@ namespace SimpleShooter.UI
                     render_text(bhopText, positionX + 10, positionY + 55, 1.0f, 0.0f, 0.0f);
                 }
                 
+                // Render frame time tail, red when it would be felt as a hitch
+                string frameText = $"Frame p99: {frameTimeP99:F1} ms";
+                if (frameTimeP99 > FRAME_TIME_WARNING_MS)
+                {
+                    render_text(frameText, positionX + 10, positionY + 75, 1.0f, 0.3f, 0.3f);
+                }
+                else
+                {
+                    render_text(frameText, positionX + 10, positionY + 75, 0.8f, 0.8f, 0.8f);
+                }
+                
                 // Console fallback for debugging
                 if (currentSpeed > FAST_SPEED_THRESHOLD)
                 {
@@ -171,6 +193,7 @@ namespace SimpleShooter.UI
         public float CurrentSpeed => currentSpeed;
         public bool IsOnGround => isOnGround;
         public Color CurrentColor => currentColor;
+        public float FrameTimeP99 => frameTimeP99;
         public bool IsInitialized => initialized;
         
         // Position getters
@@ -31,20 +31,55 @@ namespace SimpleShooter.UI
         public float horizontal_speed;
         public float last_jump_time;
         public int consecutive_jumps;
+        public Vector3 previous_position;
     }
 
     [StructLayout(LayoutKind.Sequential)]
     public struct GameState
     {
         public PlayerState player;
-        // Note: Arrays in structs need special handling for marshaling
-        // For now, we'll get individual values through separate functions
+        // Entity arrays are runtime-sized and owned by the C core
+        public IntPtr enemies;
+        public IntPtr projectiles;
+        public int max_enemies;
+        public int max_projectiles;
         public int score;
         public int enemy_count;
         public int projectile_count;
         public float delta_time;
         public int game_running;
         public int current_phase;
+        public float interpolation_alpha;
+        // Entity pools follow in the C struct and are not mirrored here
+    }
+
+    // Matches FrameStatsSummary in core/frame_stats.h
+    [StructLayout(LayoutKind.Sequential)]
+    public struct FrameStatsSummary
+    {
+        public uint samples;
+        public float mean_ms;
+        public float p50_ms;
+        public float p95_ms;
+        public float p99_ms;
+        public float p999_ms;
+        public float max_ms;
+        public int hitch_threshold_count;
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 4)]
+        public float[] hitch_threshold_ms;
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 4)]
+        public uint[] hitches;
+    }
+
+    // Values of FrameStat and FrameStatsScope in core/frame_stats.h
+    public static class FrameStats
+    {
+        public const int Frame = 0;
+        public const int Simulation = 1;
+        public const int Render = 2;
+
+        public const int Recent = 0;
+        public const int Session = 1;
     }
 
     public class UIManager
@@ -70,6 +105,12 @@ namespace SimpleShooter.UI
         [DllImport("simple_shooter", CallingConvention = CallingConvention.Cdecl)]
         private static extern int get_window_height();
 
+        [DllImport("simple_shooter", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int frame_stats_get_summary(int stat, int scope, out FrameStatsSummary summary);
+
+        [DllImport("simple_shooter", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int get_render_culling_stats(out int visible, out int culled);
+
         public bool Initialize()
         {
             Console.WriteLine("Initializing UI Manager...");
@@ -153,6 +194,7 @@ namespace SimpleShooter.UI
                     case 1: // GAME_PLAYING
                         speedometer?.Update(gameState.player.speed, gameState.player.on_ground != 0);
                         gameHUD?.Update(gameState.player, gameState.score, deltaTime);
+                        UpdateFrameStats();
                         audioSettings?.Update(deltaTime);
                         break;
                         
@@ -249,6 +291,31 @@ namespace SimpleShooter.UI
             }
         }
 
+        private void UpdateFrameStats()
+        {
+            try
+            {
+                FrameStatsSummary frame, simulation, render;
+                if (frame_stats_get_summary(FrameStats.Frame, FrameStats.Recent, out frame) != 0 &&
+                    frame_stats_get_summary(FrameStats.Simulation, FrameStats.Recent, out simulation) != 0 &&
+                    frame_stats_get_summary(FrameStats.Render, FrameStats.Recent, out render) != 0)
+                {
+                    speedometer?.UpdateFrameStats(frame);
+                    gameHUD?.UpdateFrameStats(frame, simulation, render);
+                }
+                
+                int visible, culled;
+                if (get_render_culling_stats(out visible, out culled) != 0)
+                {
+                    gameHUD?.UpdateCullingStats(visible, culled);
+                }
+            }
+            catch (Exception ex)
+            {
+                Console.WriteLine($"Failed to get frame stats: {ex.Message}");
+            }
+        }
+
         private GameState GetGameState()
         {
             try
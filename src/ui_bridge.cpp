@@ -1,5 +1,6 @@
 // Bridge between C Core Engine and C# UI Manager
 #include "game_api.h"
+#include "core/log.h"
 #include <iostream>
 
 // Global UI state
@@ -20,7 +21,7 @@ void render_text(const char* text, float x, float y, float r, float g, float b)
     // Debug output occasionally
     static int call_count = 0;
     if (++call_count % 100 == 0) {
-        printf("[UI] Rendered text: %s at (%.0f,%.0f)\n", text, x, y);
+        LOG_TRACE(LOG_CATEGORY_UI, "Rendered text: %s at (%.0f,%.0f)", text, x, y);
     }
 }
 
@@ -30,7 +31,7 @@ void render_ui_background(float x, float y, float width, float height, float r,
     // Debug output occasionally
     static int call_count = 0;
     if (++call_count % 50 == 0) {
-        printf("[UI] Rendered background at (%.0f,%.0f) size %.0fx%.0f\n", x, y, width, height);
+        LOG_TRACE(LOG_CATEGORY_UI, "Rendered background at (%.0f,%.0f) size %.0fx%.0f", x, y, width, height);
     }
 }
 
@@ -40,7 +41,7 @@ void render_crosshair(float x, float y, float size, float r, float g, float b) {
     // Debug output occasionally
     static int call_count = 0;
     if (++call_count % 200 == 0) {
-        printf("[UI] Rendered crosshair at (%.0f,%.0f) size %.0f\n", x, y, size);
+        LOG_TRACE(LOG_CATEGORY_UI, "Rendered crosshair at (%.0f,%.0f) size %.0f", x, y, size);
     }
 }
 
@@ -49,7 +50,8 @@ extern "C" GameState* get_core_game_state();
 
 // Functions that C# can call to get game data
 GameState* get_game_state() {
-    // Return the actual game state from Core Engine
+    // Return the state being presented, the latest snapshot when the
+    // simulation runs on its own thread
     return get_core_game_state();
 }
 
@@ -100,7 +102,7 @@ void update_ui_manager(float delta_time) {
     update_timer += delta_time;
     
     if (update_timer >= 1.0f) { // Update UI info every second
-        printf("[UI] UI Update - Delta: %.3f\n", delta_time);
+        LOG_TRACE(LOG_CATEGORY_UI, "UI Update - Delta: %.3f", delta_time);
         update_timer = 0.0f;
     }
 }
@@ -111,16 +113,17 @@ void render_ui_manager() {
     // In a real implementation, we would call the C# Render method
     static int render_count = 0;
     if (++render_count % 300 == 0) { // Print every 300 frames (~5 seconds at 60fps)
-        printf("[UI] UI Render call #%d\n", render_count);
+        LOG_TRACE(LOG_CATEGORY_UI, "UI Render call #%d", render_count);
     }
 }
 
 void handle_ui_input(int key, int action) {
     if (!g_ui_initialized) return;
+    (void)key; // Only used by debug logging
     
     // In a real implementation, we would call the C# HandleInput method
     if (action == 1) { // Key pressed
-        printf("[UI] UI Input: key %d pressed\n", key);
+        LOG_DEBUG(LOG_CATEGORY_UI, "UI Input: key %d pressed", key);
     }
 }
 
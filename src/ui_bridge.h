@@ -2,6 +2,7 @@
 #define UI_BRIDGE_H
 
 #include "game_api.h"
+#include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {